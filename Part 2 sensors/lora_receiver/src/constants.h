@@ -22,6 +22,14 @@
 #define RADIO_DIO0_PIN 26
 #define FREQUENCY 915E6
 
+// Seleccion de canal: escaneo RSSI al arranque y anuncio en el canal de encuentro
+// (debe coincidir con lora_transmitter/src/constants.h)
+#define RENDEZVOUS_FREQ_MHZ 915.0
+#define CHANNEL_PLAN_MHZ {915.0, 915.6, 916.2, 916.8, 917.4}
+#define CHANNEL_SCAN_WINDOW_MS 150
+#define CHANNEL_ANNOUNCE_INTERVAL_MS 30000
+#define CHANNEL_ANNOUNCE_PREFIX "@CH"
+
 // Configuración para TTGO T-Beam
 #define LORA_SCK 5
 #define LORA_MISO 19
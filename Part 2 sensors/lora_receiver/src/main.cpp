@@ -6,18 +6,27 @@
 #include "constants.h"
 #include "services.h"
 #include "repository.h"
+#include "LoRaRx.h"
+#include "AsyncLog.h"
 
 int state = 1;
+unsigned long last_announce = 0;
 
 // Buffer JSON persistente entre iteraciones
 DynamicJsonDocument orion_data_new(8192);
 
+// Buffers de paquetes LoRa reservados una sola vez (sin heap por paquete)
+LoRaRx::PacketPool<2> rx_pool;
+
 void setup()
 {
     Serial.begin(SERIAL_BAUDRATE);
+    AsyncLog::begin();
     pinMode(LED, OUTPUT);
 
     Lora_connection();
+    Select_channel();
+    last_announce = millis();
     WiFi_connection();
 
     // Check if the subscription is active
@@ -26,7 +35,7 @@ void setup()
         // Reintentar WiFi si se cayó
         if (WiFi.status() != WL_CONNECTED)
         {
-            Serial.println("[INFO] WiFi desconectado - Reintentando...");
+            LOG_I("[INFO] WiFi desconectado - Reintentando...");
             WiFi_connection();
             delay(1000);
             continue;
@@ -39,31 +48,31 @@ void setup()
         {
             if (Has_description_and_type(sucriptions, SUSCRIPTION_DESCRIPTION, SUSCRIPTION_TYPE))
             {
-                Serial.println("[GOOD] Description and type found");
+                LOG_I("[GOOD] Description and type found");
                 delay(2000);
                 break;
             }
             else
             {
-                Serial.println("[BAD] The condition (description+type) was not met");
+                LOG_W("[BAD] The condition (description+type) was not met");
                 bool subscription = Post_subscription(SUSCRIPTION_DESCRIPTION, SUSCRIPTION_TYPE, URL_SERVER_NOTIFICATION_SUBS);
                 delay(2000);
                 if (subscription)
                 {
-                    Serial.println("[GOOD] The subscription was created");
+                    LOG_I("[GOOD] The subscription was created");
                     break;
                 }
             }
         }
         else
         {
-            Serial.println("[BAD] Unable to get subscriptions, sleeping for 3 seconds");
+            LOG_W("[BAD] Unable to get subscriptions, sleeping for 3 seconds");
             // sleep(3000);  // En ESP32 esto es en segundos; usa delay en ms
             delay(3000);
         }
     }
 
-    Serial.println("[OK] FIWARE LoRa Receiver Ready - Waiting for data...");
+    LOG_I("[OK] FIWARE LoRa Receiver Ready - Waiting for data...");
 }
 
 void loop()
@@ -73,33 +82,35 @@ void loop()
     {
     case 1: // RECEIVE - CHIRP - Esperar datos LoRa del receptor
     {
+        // Re-anunciar el canal para transmisores que arrancaron después
+        if (millis() - last_announce >= CHANNEL_ANNOUNCE_INTERVAL_MS)
+        {
+            Announce_channel();
+            last_announce = millis();
+        }
+
         int packetSize = LoRa.parsePacket();
 
         if (packetSize)
         {
-            // Read message
-            String message = "";
-            while (LoRa.available())
+            // Read message (una sola ráfaga SPI al buffer del pool)
+            LoRaRx::Packet *packet = rx_pool.acquire();
+            if (!packet)
             {
-                message += (char)LoRa.read();
+                LOG_W("[BAD] LoRa rx pool exhausted - packet dropped");
+                break;
             }
-
-            int rssi = LoRa.packetRssi();
-            long error_hz = LoRa.packetFrequencyError();
-            float snr = LoRa.packetSnr();
+            LoRaRx::readPacket(packetSize, RADIO_CS_PIN, *packet);
 
             // ...existing code...
-            Serial.println("=== DATO RECIBIDO ===");
-            Serial.printf("Mensaje: %s\n", message.c_str());
-            Serial.printf("RSSI: %d dBm\t Packet Frequency Error: %ld Hz\t SNR: %.2f dB\n",
-                          rssi, error_hz, snr);
-
-            // Create JSON
-            orion_data_new = Create_orion_package(message, rssi, snr, error_hz);
-            String preview;
-            serializeJson(orion_data_new, preview);
-            Serial.println("[XXXXXXXXXXXXXXXXXXXXXXXXXXXXX] Payload :");
-            Serial.println(preview);
+            LOG_I("=== DATO RECIBIDO ===");
+            LOG_D("Mensaje: %s", packet->c_str());
+            LOG_I("RSSI: %d dBm\t Packet Frequency Error: %ld Hz\t SNR: %.2f dB",
+                  packet->rssi, packet->frequencyError, packet->snr);
+
+            // Create JSON (Create_orion_package ya registra el payload en debug)
+            orion_data_new = Create_orion_package(*packet);
+            rx_pool.release(packet);
             // ...existing code...
             state = 2;
         }
@@ -110,11 +121,11 @@ void loop()
     case 2:
     {
 
-        Serial.println("[INFO] Sending data to FIWARE Orion...");
+        LOG_I("[INFO] Sending data to FIWARE Orion...");
 
         if (WiFi.status() != WL_CONNECTED)
         {
-            Serial.println("WiFi desconectado - Reconectando...");
+            LOG_W("WiFi desconectado - Reconectando...");
             WiFi_connection();
             delay(1000);
         }
@@ -124,13 +135,13 @@ void loop()
             bool success = Patch_entity_attrs(ID, orion_data_new);
             if (success)
             {
-                Serial.println("[GOOD] Data successfully sent to FIWARE");
+                LOG_I("[GOOD] Data successfully sent to FIWARE");
                 state = 3;
             }
             else
             {
-                Serial.println("[BAD] Failed to send to FIWARE");
-                Serial.println("[INFO] Create the entity in Orion");
+                LOG_W("[BAD] Failed to send to FIWARE");
+                LOG_I("[INFO] Create the entity in Orion");
 
                 DynamicJsonDocument orion_data_copy(8192);
 
@@ -143,19 +154,19 @@ void loop()
 
                 if (success)
                 {
-                    Serial.println("[GOOD] Data successfully sent to FIWARE and a new entity was created");
+                    LOG_I("[GOOD] Data successfully sent to FIWARE and a new entity was created");
                     state = 3;
                 }
                 else
                 {
-                    Serial.println("[BAD] Unable to create entity in Orion");
+                    LOG_E("[BAD] Unable to create entity in Orion");
                     delay(1000);
                 }
             }
         }
         else
         {
-            Serial.println("[BAD] Could not connect to WiFi");
+            LOG_W("[BAD] Could not connect to WiFi");
         }
 
         break;
@@ -163,7 +174,7 @@ void loop()
 
     case 3: // WAIT - Breve espera
     {
-        Serial.println("[OK] Waiting 2 seconds...");
+        LOG_I("[OK] Waiting 2 seconds...");
         delay(2000);
         state = 1;
         break;
@@ -171,7 +182,7 @@ void loop()
 
     default:
     {
-        Serial.println("[BAD] Unrecognized State - Restarting");
+        LOG_W("[BAD] Unrecognized State - Restarting");
         state = 1;
         break;
     }
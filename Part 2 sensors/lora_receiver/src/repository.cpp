@@ -2,27 +2,28 @@
 #include <HTTPClient.h>
 #include "repository.h"
 #include "config.h"
+#include "AsyncLog.h"
 
 
 void Http_errors(int httpCode) {
     // Client error (4xx)
     if (httpCode >= 400 && httpCode < 500) {
-        Serial.printf("[HTTP] [Get_subscriptions] Client error: %d\n", httpCode);
+        LOG_W("[HTTP] [Get_subscriptions] Client error: %d", httpCode);
     }
     // Server error (5xx)
     else if (httpCode >= 500) {
-        Serial.printf("[HTTP] [Get_subscriptions] Server error: %d\n", httpCode);
+        LOG_W("[HTTP] [Get_subscriptions] Server error: %d", httpCode);
     }
     // Otros códigos inesperados
     else {
-        Serial.printf("[HTTP] [Get_subscriptions] Unexpected HTTP code: %d\n", httpCode);
+        LOG_W("[HTTP] [Get_subscriptions] Unexpected HTTP code: %d", httpCode);
     }
 }
 
 DynamicJsonDocument Get_subscriptions() {
     HTTPClient http;
     const String url = URL_SERVER  "/subscriptions";
-    Serial.println("\n[HTTP] [Get_subscriptions] begin... " + url);
+    LOG_I("[HTTP] [Get_subscriptions] begin... %s", url.c_str());
 
     http.setReuse(true);
     http.begin(url);
@@ -33,8 +34,8 @@ DynamicJsonDocument Get_subscriptions() {
 
     // No connection / network error
     if (httpCode <= 0) {
-        Serial.printf("[HTTP] [Get_subscriptions] GET failed, error: %s\n",
-                      HTTPClient::errorToString(httpCode).c_str());
+        LOG_W("[HTTP] [Get_subscriptions] GET failed, error: %s",
+              HTTPClient::errorToString(httpCode).c_str());
         http.end();
         return DynamicJsonDocument(1); // vacío
     }
@@ -42,8 +43,8 @@ DynamicJsonDocument Get_subscriptions() {
     // OK -> parse JSON
     if (httpCode == HTTP_CODE_OK) {
         const String response = http.getString();
-        Serial.println("[HTTP] [Get_subscriptions] Response received:");
-        Serial.println(response);
+        LOG_D("[HTTP] [Get_subscriptions] Response received:");
+        LOG_DUMP(response.c_str());
 
         DynamicJsonDocument responseDoc(4096);
         DeserializationError error = deserializeJson(responseDoc, response);
@@ -53,8 +54,7 @@ DynamicJsonDocument Get_subscriptions() {
             return responseDoc;
         }
 
-        Serial.print("[HTTP] [Get_subscriptions] Error parsing JSON: ");
-        Serial.println(error.c_str());
+        LOG_W("[HTTP] [Get_subscriptions] Error parsing JSON: %s", error.c_str());
         http.end();
         return DynamicJsonDocument(1); // vacío
     }
@@ -71,7 +71,7 @@ bool Post_subscription(const char *description, const char *type, const char *no
 {
     HTTPClient http;
     const String url = URL_SERVER "/subscriptions";
-    Serial.println("\n[HTTP] [Post_subscription] begin... " + url);
+    LOG_I("[HTTP] [Post_subscription] begin... %s", url.c_str());
 
     http.setReuse(true);
     http.begin(url);
@@ -119,24 +119,24 @@ bool Post_subscription(const char *description, const char *type, const char *no
     // Serializar
     String body;
     serializeJson(payload, body);
-    Serial.println("[HTTP] [Post_subscription] Payload:");
-    Serial.println(body);
+    LOG_D("[HTTP] [Post_subscription] Payload:");
+    LOG_DUMP(body.c_str());
 
     int httpCode = http.POST(body);
 
     if (httpCode <= 0) {
-        Serial.printf("[HTTP] [Post_subscription] POST failed, error: %s\n",
-                      HTTPClient::errorToString(httpCode).c_str());
+        LOG_W("[HTTP] [Post_subscription] POST failed, error: %s",
+              HTTPClient::errorToString(httpCode).c_str());
         http.end();
         return false;
     }
 
     if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_CREATED) {
-        Serial.printf("[HTTP] [Post_subscription] Success, code: %d\n", httpCode);
+        LOG_I("[HTTP] [Post_subscription] Success, code: %d", httpCode);
         String response = http.getString();
         if (response.length()) {
-            Serial.println("[HTTP] [Post_subscription] Response:");
-            Serial.println(response);
+            LOG_D("[HTTP] [Post_subscription] Response:");
+            LOG_DUMP(response.c_str());
         }
         http.end();
         return true;
@@ -146,8 +146,8 @@ bool Post_subscription(const char *description, const char *type, const char *no
     Http_errors(httpCode);
     String response = http.getString();
     if (response.length()) {
-        Serial.println("[HTTP] [Post_subscription] Response:");
-        Serial.println(response);
+        LOG_W("[HTTP] [Post_subscription] Response:");
+        AsyncLog::writeText(response.c_str());
     }
     http.end();
     return false;
@@ -161,7 +161,7 @@ bool Patch_entity_attrs(const char *entityId, const DynamicJsonDocument &bodyDoc
 {
     HTTPClient http;
     String url = String(URL_SERVER) + "/entities/" + String(entityId) + "/attrs";
-    Serial.println("\n[HTTP] [Patch_entity_attrs] begin... " + url);
+    LOG_I("[HTTP] [Patch_entity_attrs] begin... %s", url.c_str());
 
     http.begin(url);
     http.addHeader("Content-Type", "application/json");
@@ -169,8 +169,8 @@ bool Patch_entity_attrs(const char *entityId, const DynamicJsonDocument &bodyDoc
     // Serializar documento al cuerpo
     String body;
     serializeJson(bodyDoc, body);
-    Serial.println("[HTTP] [Patch_entity_attrs] Body:");
-    Serial.println(body);
+    LOG_D("[HTTP] [Patch_entity_attrs] Body:");
+    LOG_DUMP(body.c_str());
 
     // Enviar PATCH. Algunos cores soportan http.PATCH(body) directamente;
     // usamos sendRequest para mayor compatibilidad.
@@ -182,8 +182,8 @@ bool Patch_entity_attrs(const char *entityId, const DynamicJsonDocument &bodyDoc
     // Error de conexión / red
     if (httpCode <= 0)
     {
-        Serial.printf("[HTTP] [Patch_entity_attrs] PATCH failed, error: %s\n",
-                      HTTPClient::errorToString(httpCode).c_str());
+        LOG_W("[HTTP] [Patch_entity_attrs] PATCH failed, error: %s",
+              HTTPClient::errorToString(httpCode).c_str());
         http.end();
         return false;
     }
@@ -191,7 +191,7 @@ bool Patch_entity_attrs(const char *entityId, const DynamicJsonDocument &bodyDoc
     // Aceptar 204 No Content (typical FIWARE), 200 o 201 como éxito
     if (httpCode == HTTP_CODE_NO_CONTENT || httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_CREATED)
     {
-        Serial.printf("[HTTP] [Patch_entity_attrs] Success, code: %d\n", httpCode);
+        LOG_I("[HTTP] [Patch_entity_attrs] Success, code: %d", httpCode);
         /*
         String response = http.getString();
         Serial.println(response);
@@ -205,8 +205,8 @@ bool Patch_entity_attrs(const char *entityId, const DynamicJsonDocument &bodyDoc
     String response = http.getString();
     if (response.length())
     {
-        Serial.println("[HTTP] [Patch_entity_attrs] Response:");
-        Serial.println(response);
+        LOG_W("[HTTP] [Patch_entity_attrs] Response:");
+        AsyncLog::writeText(response.c_str());
     }
 
     http.end();
@@ -8,6 +8,9 @@
 
 #include "ClosedCube_HDC1080.h"
 #include "LoRaBoards.h"
+#include "LoRaRx.h"
+#include "ChannelScan.h"
+#include "AsyncLog.h"
 
 // ----- CONFIGURACIÓN LORA -----
 #ifndef CONFIG_RADIO_FREQ
@@ -20,6 +23,11 @@
 #define CONFIG_RADIO_BW 125.0
 #endif
 
+// ----- SELECCIÓN DE CANAL -----
+const float channel_plan[] = CHANNEL_PLAN_MHZ;
+ChannelScan::Report channel_scan = {};
+uint8_t data_channel = 0;
+
 // ----- CONFIGURACIÓN HDC1080 -----
 ClosedCube_HDC1080 hdc1080;
 // Use board-default I2C pins from utilities.h (I2C_SDA / I2C_SCL)
@@ -61,9 +69,11 @@ void Lora_connection()
 #endif
 
     LoRa.setPins(RADIO_CS_PIN, RADIO_RST_PIN, RADIO_DIO0_PIN);
+    LoRaRx::configureSpi();
     if (!LoRa.begin(CONFIG_RADIO_FREQ * 1000000))
     {
-        Serial.println("Error al iniciar LoRa!");
+        LOG_E("Error al iniciar LoRa!");
+        AsyncLog::flush();
         while (1)
             ;
     }
@@ -73,48 +83,75 @@ void Lora_connection()
     LoRa.setCodingRate4(7);
     LoRa.setSyncWord(0xAB);
 
-    Serial.println("LoRa, GPS y HDC1080 listos!");
+    LOG_I("LoRa, GPS y HDC1080 listos!");
+}
+
+// Escanea el plan de canales y se queda en el más silencioso
+void Select_channel()
+{
+    LOG_I("===========> CANAL LORA <============");
+    data_channel = ChannelScan::scan(channel_plan, sizeof(channel_plan) / sizeof(channel_plan[0]),
+                                     CHANNEL_SCAN_WINDOW_MS, channel_scan);
+    AsyncLog::flush(); // el reporte del escaneo va directo a Serial
+    ChannelScan::print(Serial, channel_scan);
+    LOG_I("Canal de datos %u (%.1f MHz), encuentro %.1f MHz",
+          data_channel, channel_plan[data_channel], RENDEZVOUS_FREQ_MHZ);
+    Announce_channel();
+}
+
+// Publica el canal elegido en el canal de encuentro para el transmisor
+void Announce_channel()
+{
+    char announce[8];
+    snprintf(announce, sizeof(announce), CHANNEL_ANNOUNCE_PREFIX "%u", data_channel);
+
+    LoRa.idle();
+    LoRa.setFrequency(RENDEZVOUS_FREQ_MHZ * 1000000);
+    LoRa.beginPacket();
+    LoRa.print(announce);
+    bool sent = LoRa.endPacket() == 1;
+    LoRa.idle();
+    LoRa.setFrequency(channel_plan[data_channel] * 1000000);
+    LoRa.receive();
+
+    LOG_I("[CANAL] Anuncio %s en %.1f MHz %s", announce, RENDEZVOUS_FREQ_MHZ,
+          sent ? "enviado" : "fallido");
 }
 
 void WiFi_connection()
 {
-    Serial.println("===========> WIFI <============");
-    Serial.println("Connecting to " + String(SSID));
+    LOG_I("===========> WIFI <============");
+    LOG_I("Connecting to %s", SSID);
     WiFi.begin(SSID, PASSWORD);
 
     int attempts = 0;
     while (WiFi.status() != WL_CONNECTED && attempts < 20)
     {
         delay(500);
-        Serial.print(".");
         attempts++;
         digitalWrite(LED, !digitalRead(LED));
     }
 
     if (WiFi.status() == WL_CONNECTED)
     {
-        Serial.println("\nWiFi connected");
-        Serial.print("IP address: ");
-        Serial.println(WiFi.localIP());
+        LOG_I("WiFi connected after %d attempts", attempts);
+        LOG_I("IP address: %s", WiFi.localIP().toString().c_str());
         digitalWrite(LED, HIGH);
     }
     else
     {
-        Serial.println("\nError conectando WiFi!");
+        LOG_E("Error conectando WiFi!");
         digitalWrite(LED, LOW);
     }
-
-    Serial.println();
 }
 
-DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, long error_hz)
+DynamicJsonDocument Create_orion_package(const LoRaRx::Packet &packet)
 {
     DynamicJsonDocument msgDoc(4096);
-    DeserializationError err = deserializeJson(msgDoc, message);
+    DeserializationError err = deserializeJson(msgDoc, packet.data, packet.length);
     if (err)
     {
-        Serial.print("[Create_orion_package] Error parseando atributos: ");
-        Serial.println(err.c_str());
+        LOG_W("[Create_orion_package] Error parseando atributos: %s", err.c_str());
     }
 
     // Documento de salida en formato NGSIv2 (como sucription.json)
@@ -156,7 +193,7 @@ DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, lo
     // Atributos LoRa y timestamp (con metadatos, siguiendo sucription.json)
     {
         JsonObject rssiObj = outDoc.createNestedObject("lora_received_power");
-        rssiObj["value"] = rssi;
+        rssiObj["value"] = packet.rssi;
         rssiObj["type"] = "Integer";
         JsonObject rssiMeta = rssiObj.createNestedObject("metadata");
         JsonObject rssiUnitCode = rssiMeta.createNestedObject("unitCode");
@@ -168,7 +205,7 @@ DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, lo
     }
     {
         JsonObject snrObj = outDoc.createNestedObject("lora_signal_quality");
-        snrObj["value"] = (int)snr; // si prefieres Float, cambia "type" y castea
+        snrObj["value"] = (int)packet.snr; // si prefieres Float, cambia "type" y castea
         snrObj["type"] = "Integer";
         JsonObject snrMeta = snrObj.createNestedObject("metadata");
         JsonObject snrUnitCode = snrMeta.createNestedObject("unitCode");
@@ -180,7 +217,7 @@ DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, lo
     }
     {
         JsonObject ferrObj = outDoc.createNestedObject("lora_frequency_error");
-        ferrObj["value"] = error_hz;
+        ferrObj["value"] = packet.frequencyError;
         ferrObj["type"] = "Integer";
         JsonObject ferrMeta = ferrObj.createNestedObject("metadata");
         JsonObject ferrUnitCode = ferrMeta.createNestedObject("unitCode");
@@ -190,9 +227,29 @@ DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, lo
         ferrUnit["value"] = "hertz";
         ferrUnit["type"] = "Text";
     }
+    {
+        const ChannelScan::Result &chosen = channel_scan.channels[channel_scan.best];
+        JsonObject chObj = outDoc.createNestedObject("lora_channel_frequency");
+        chObj["value"] = chosen.frequencyMHz;
+        chObj["type"] = "Float";
+        JsonObject chMeta = chObj.createNestedObject("metadata");
+        JsonObject chUnitCode = chMeta.createNestedObject("unitCode");
+        chUnitCode["value"] = "MHZ";
+        chUnitCode["type"] = "Text";
+        JsonObject chNoise = chMeta.createNestedObject("scanNoiseFloor");
+        chNoise["value"] = (int)chosen.averageRssi;
+        chNoise["type"] = "Integer";
+        JsonObject chScan = chMeta.createNestedObject("scanAverageRssi");
+        JsonArray chScanValues = chScan.createNestedArray("value");
+        for (size_t i = 0; i < channel_scan.count; ++i)
+        {
+            chScanValues.add((int)channel_scan.channels[i].averageRssi);
+        }
+        chScan["type"] = "StructuredValue";
+    }
     {
         JsonObject tsObj = outDoc.createNestedObject("timestamp_received");
-        tsObj["value"] = (int)millis();
+        tsObj["value"] = (int)packet.receivedAtMs;
         tsObj["type"] = "Integer";
         JsonObject tsMeta = tsObj.createNestedObject("metadata");
         JsonObject tsUnitCode = tsMeta.createNestedObject("unitCode");
@@ -203,11 +260,14 @@ DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, lo
         tsUnit["type"] = "Text";
     }
 
-    // Log opcional
-    String preview;
-    serializeJson(outDoc, preview);
-    Serial.println("[Create_orion_package] Payload NGSIv2:");
-    Serial.println(preview);
+    // Log opcional: solo se serializa si el nivel debug está compilado
+    if (AsyncLog::enabled(AsyncLog::Level::Debug))
+    {
+        String preview;
+        serializeJson(outDoc, preview);
+        LOG_D("[Create_orion_package] Payload NGSIv2:");
+        LOG_DUMP(preview.c_str());
+    }
 
     return outDoc;
 }
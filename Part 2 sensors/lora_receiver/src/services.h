@@ -1,9 +1,13 @@
 #ifndef services
 #define services
 
+#include "LoRaRx.h"
+
 void Lora_connection();
 void WiFi_connection();
-DynamicJsonDocument Create_orion_package(String message, int rssi, float snr, long error_hz);
+void Select_channel();
+void Announce_channel();
+DynamicJsonDocument Create_orion_package(const LoRaRx::Packet &packet);
 bool Has_description_and_type(const DynamicJsonDocument &doc, const char *wanted_description, const char *wanted_type);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+#include <Arduino.h>
+#include <stdarg.h>
+#include <atomic>
+
+// Asynchronous line logger shared by every firmware in this repo.
+//
+// LOG_E/LOG_W/LOG_I/LOG_D(fmt, ...) format one line into a slot of a
+// lock-free multi-producer ring and return; a low-priority task started by
+// AsyncLog::begin() writes finished lines to Serial. At 115200 baud a
+// 60-character line is ~5 ms of UART once the TX FIFO is full, which the
+// caller no longer waits for. The newline is added by the logger.
+//
+// Levels above ASYNC_LOG_LEVEL are compiled out: the macro condition is a
+// constant expression, so the call, its arguments and its format string
+// never reach the binary. A full ring drops the line rather than blocking
+// (counted, and reported by the drain task); lines longer than
+// ASYNC_LOG_LINE_MAX are truncated, except through LOG_DUMP, which splits
+// long text such as JSON payloads over several lines at debug level.
+#define ASYNC_LOG_NONE 0
+#define ASYNC_LOG_ERROR 1
+#define ASYNC_LOG_WARN 2
+#define ASYNC_LOG_INFO 3
+#define ASYNC_LOG_DEBUG 4
+
+#ifndef ASYNC_LOG_LEVEL
+#define ASYNC_LOG_LEVEL ASYNC_LOG_INFO
+#endif
+#ifndef ASYNC_LOG_LINES
+#define ASYNC_LOG_LINES 32           // ring slots, power of two
+#endif
+#ifndef ASYNC_LOG_LINE_MAX
+#define ASYNC_LOG_LINE_MAX 128       // bytes per line, including the terminator
+#endif
+
+namespace AsyncLog {
+
+enum class Level : uint8_t {
+  Error = ASYNC_LOG_ERROR,
+  Warn = ASYNC_LOG_WARN,
+  Info = ASYNC_LOG_INFO,
+  Debug = ASYNC_LOG_DEBUG
+};
+
+constexpr bool enabled(Level level) {
+  return static_cast<uint8_t>(level) <= ASYNC_LOG_LEVEL;
+}
+
+constexpr size_t kLines = ASYNC_LOG_LINES;
+constexpr size_t kLineMax = ASYNC_LOG_LINE_MAX;
+constexpr uint32_t kDrainIdleMs = 20;
+static_assert(kLines >= 2 && (kLines & (kLines - 1)) == 0, "ASYNC_LOG_LINES must be a power of two");
+
+// Bounded MPSC queue (Vyukov): a producer claims a slot with one CAS on the
+// enqueue index, formats into it and publishes it by bumping the slot's
+// sequence. The drain task is the only consumer.
+class Ring {
+public:
+  Ring() {
+    for (size_t i = 0; i < kLines; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Any task. Returns false (and counts a drop) when the ring is full.
+  bool vprintf(const char *format, va_list args) {
+    size_t pos = enqueue_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & (kLines - 1)];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = enqueue_.load(std::memory_order_relaxed);
+      }
+    }
+
+    int length = vsnprintf(cell->text, kLineMax, format, args);
+    if (length < 0) {
+      length = 0;
+    } else if (static_cast<size_t>(length) >= kLineMax) {
+      length = kLineMax - 1;
+      truncated_.fetch_add(1, std::memory_order_relaxed);
+    }
+    cell->length = static_cast<uint16_t>(length);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Drain task only. Writes up to maxLines finished lines; returns the count.
+  size_t drainTo(Print &out, size_t maxLines) {
+    size_t lines = 0;
+    while (lines < maxLines) {
+      Cell &cell = cells_[dequeue_ & (kLines - 1)];
+      if (cell.sequence.load(std::memory_order_acquire) != dequeue_ + 1) {
+        break;
+      }
+      out.write(reinterpret_cast<const uint8_t *>(cell.text), cell.length);
+      out.write('\n');
+      cell.sequence.store(dequeue_ + kLines, std::memory_order_release);
+      ++dequeue_;
+      ++lines;
+    }
+    written_ += lines;
+    return lines;
+  }
+
+  bool pending() const { return enqueue_.load(std::memory_order_relaxed) != dequeue_; }
+  uint32_t written() const { return written_; }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  uint32_t truncated() const { return truncated_.load(std::memory_order_relaxed); }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    uint16_t length;
+    char text[kLineMax];
+  };
+
+  Cell cells_[kLines];
+  std::atomic<size_t> enqueue_{0};
+  volatile size_t dequeue_ = 0;
+  uint32_t written_ = 0;
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> truncated_{0};
+};
+
+inline Ring &ring() {
+  static Ring instance;
+  return instance;
+}
+
+inline void write(const char *format, ...) __attribute__((format(printf, 1, 2)));
+inline void write(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  ring().vprintf(format, args);
+  va_end(args);
+}
+
+inline void writeText(const char *text) {
+  const size_t length = strlen(text);
+  for (size_t offset = 0; offset < length; offset += kLineMax - 1) {
+    const size_t chunk = length - offset < kLineMax - 1 ? length - offset : kLineMax - 1;
+    write("%.*s", static_cast<int>(chunk), text + offset);
+  }
+}
+
+inline void drainTask(void *) {
+  uint32_t reportedDrops = 0;
+  for (;;) {
+    const size_t lines = ring().drainTo(Serial, kLines);
+    const uint32_t dropped = ring().dropped();
+    if (dropped != reportedDrops) {
+      Serial.printf("[LOG] %lu lines dropped\n", static_cast<unsigned long>(dropped - reportedDrops));
+      reportedDrops = dropped;
+    }
+    if (lines == 0) {
+      vTaskDelay(pdMS_TO_TICKS(kDrainIdleMs));
+    }
+  }
+}
+
+// Call right after Serial.begin(); lines logged before it are kept.
+inline void begin(UBaseType_t priority = 1, BaseType_t core = tskNO_AFFINITY) {
+  static TaskHandle_t handle = nullptr;
+  if (!handle) {
+    ring();
+    xTaskCreatePinnedToCore(drainTask, "log", 3072, nullptr, priority, &handle, core);
+  }
+}
+
+// Wait (bounded) until queued lines are out, e.g. before printing straight
+// to Serial or restarting.
+inline void flush(uint32_t timeoutMs = 200) {
+  const uint32_t start = millis();
+  while (ring().pending() && millis() - start < timeoutMs) {
+    vTaskDelay(1);
+  }
+}
+
+}  // namespace AsyncLog
+
+#define ASYNC_LOG_AT(level, ...)                 \
+  do {                                           \
+    if (::AsyncLog::enabled(level)) {            \
+      ::AsyncLog::write(__VA_ARGS__);            \
+    }                                            \
+  } while (0)
+
+#define LOG_E(...) ASYNC_LOG_AT(::AsyncLog::Level::Error, __VA_ARGS__)
+#define LOG_W(...) ASYNC_LOG_AT(::AsyncLog::Level::Warn, __VA_ARGS__)
+#define LOG_I(...) ASYNC_LOG_AT(::AsyncLog::Level::Info, __VA_ARGS__)
+#define LOG_D(...) ASYNC_LOG_AT(::AsyncLog::Level::Debug, __VA_ARGS__)
+
+#define LOG_DUMP(text)                                       \
+  do {                                                       \
+    if (::AsyncLog::enabled(::AsyncLog::Level::Debug)) {     \
+      ::AsyncLog::writeText(text);                           \
+    }                                                        \
+  } while (0)
@@ -9,4 +9,14 @@
 #define NAME "GPS-temperature-and-humidity-sensor"
 #define ID 19253
 
+// Seleccion de canal: el receptor anuncia su canal en el canal de encuentro
+// (debe coincidir con lora_receiver/src/constants.h)
+#define RENDEZVOUS_FREQ_MHZ 915.0
+#define CHANNEL_PLAN_MHZ {915.0, 915.6, 916.2, 916.8, 917.4}
+#define CHANNEL_ANNOUNCE_INTERVAL_MS 30000
+#define CHANNEL_ANNOUNCE_PREFIX "@CH"
+#define CHANNEL_RESYNC_INTERVAL_MS 300000
+#define CHANNEL_RESYNC_MAX_INTERVAL_MS 1800000 // espera máxima tras fallos seguidos
+#define CHANNEL_LISTEN_WINDOW_MS (CHANNEL_ANNOUNCE_INTERVAL_MS + 2000)
+
 #endif // CONSTANTS_H
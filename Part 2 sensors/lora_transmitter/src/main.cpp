@@ -6,6 +6,7 @@
 #include "ClosedCube_HDC1080.h"
 #include "LoRaBoards.h"
 #include "constants.h"
+#include "AsyncLog.h"
 
 // ----- CONFIGURACIÓN LORA -----
 #ifndef CONFIG_RADIO_FREQ
@@ -29,16 +30,128 @@ HardwareSerial gpsSerial(1); // UART1 para el GPS
 ClosedCube_HDC1080 hdc1080;
 // Use board-default I2C pins from utilities.h (I2C_SDA / I2C_SCL)
 
+// ----- SELECCIÓN DE CANAL -----
+// Sin anuncio el nodo transmite en el canal de encuentro, que es donde
+// escucha el slot de sensores del gateway (nunca anuncia canal). Una vez
+// sincronizado, solo vuelve al canal de encuentro en ventanas de escucha.
+const float channel_plan[] = CHANNEL_PLAN_MHZ;
+const int channel_count = sizeof(channel_plan) / sizeof(channel_plan[0]);
+int canalDatos = -1;                  // canal anunciado; -1 = nunca sincronizado
+bool escuchando = false;              // radio en el canal de encuentro
+unsigned long inicioEscucha = 0;
+unsigned long lastChannelSync = 0;    // fin del último intento
+unsigned long resyncEvery = CHANNEL_RESYNC_INTERVAL_MS;
+
 // ----- VARIABLES -----
 unsigned long lastSend = 0;
 int counter = 0;
 
+// -------------------------------------------------------------------
+void sintonizar(float mhz)
+{
+  LoRa.idle();
+  LoRa.setFrequency(mhz * 1000000);
+}
+
+// Abre una ventana de escucha en el canal de encuentro. No bloquea: loop()
+// sigue enviando cada 3 s y atenderCanal() revisa el anuncio entre envíos.
+void abrirEscucha()
+{
+  sintonizar(RENDEZVOUS_FREQ_MHZ);
+  escuchando = true;
+  inicioEscucha = millis();
+  LOG_I("Buscando canal en %.1f MHz...", RENDEZVOUS_FREQ_MHZ);
+}
+
+// Cierra la ventana. Tras un fallo se duplica la espera hasta el siguiente
+// intento; sin canal conocido se sigue escuchando entre envíos (ya se
+// transmite en el canal de encuentro, así que no cuesta nada).
+void cerrarEscucha(bool anunciado)
+{
+  lastChannelSync = millis();
+  if (canalDatos < 0)
+  {
+    inicioEscucha = lastChannelSync;
+    LOG_I("Sin anuncio de canal; se transmite en el canal de encuentro");
+    return;
+  }
+
+  escuchando = false;
+  sintonizar(channel_plan[canalDatos]);
+  if (anunciado)
+  {
+    resyncEvery = CHANNEL_RESYNC_INTERVAL_MS;
+  }
+  else
+  {
+    resyncEvery = min(resyncEvery * 2, (unsigned long)CHANNEL_RESYNC_MAX_INTERVAL_MS);
+    LOG_I("Sin anuncio de canal; se mantiene el canal %d, reintento en %lu s",
+          canalDatos, resyncEvery / 1000);
+  }
+}
+
+// Lee un anuncio pendiente ("@CH<n>") sin bloquear y adopta el canal.
+bool revisarAnuncio()
+{
+  int packetSize = LoRa.parsePacket();
+  if (packetSize <= 0)
+  {
+    return false;
+  }
+
+  char announce[16] = {0};
+  int len = 0;
+  while (LoRa.available() && len < (int)sizeof(announce) - 1)
+  {
+    announce[len++] = (char)LoRa.read();
+  }
+
+  const size_t prefixLen = strlen(CHANNEL_ANNOUNCE_PREFIX);
+  if (strncmp(announce, CHANNEL_ANNOUNCE_PREFIX, prefixLen) != 0)
+  {
+    return false;
+  }
+  int channel = atoi(announce + prefixLen);
+  if (channel < 0 || channel >= channel_count)
+  {
+    return false;
+  }
+
+  canalDatos = channel;
+  LOG_I("Canal %d (%.1f MHz) anunciado por el receptor (RSSI %d dBm)",
+        channel, channel_plan[channel], LoRa.packetRssi());
+  return true;
+}
+
+// Re-sincroniza por si el receptor reinició y eligió otro canal.
+void atenderCanal()
+{
+  if (!escuchando)
+  {
+    if (millis() - lastChannelSync > resyncEvery)
+    {
+      abrirEscucha();
+    }
+    return;
+  }
+
+  if (revisarAnuncio())
+  {
+    cerrarEscucha(true);
+  }
+  else if (millis() - inicioEscucha > CHANNEL_LISTEN_WINDOW_MS)
+  {
+    cerrarEscucha(false);
+  }
+}
+
 // -------------------------------------------------------------------
 void setup()
 {
   Serial.begin(115200);
+  AsyncLog::begin();
   delay(1000);
-  Serial.println("Iniciando TTGO T-Beam LoRa + GPS + HDC1080");
+  LOG_I("Iniciando TTGO T-Beam LoRa + GPS + HDC1080");
 
   // --- Enciende GPS (AXP2101 puede apagarlo por defecto) ---
   pinMode(14, OUTPUT); // algunas T-Beam V1.2 usan GPIO14 para power GPS
@@ -47,7 +160,7 @@ void setup()
 
   // --- Inicializa GPS ---
   gpsSerial.begin(GPS_BAUD, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
-  Serial.println("GPS inicializado");
+  LOG_I("GPS inicializado");
 
   // --- Inicializa sensor HDC1080 ---
 #ifdef I2C_SDA
@@ -57,10 +170,8 @@ void setup()
   Wire.begin();
 #endif
   hdc1080.begin(0x40);
-  Serial.print("Fabricante HDC1080 ID: ");
-  Serial.println(hdc1080.readManufacturerId(), HEX);
-  Serial.print("Dispositivo HDC1080 ID: ");
-  Serial.println(hdc1080.readDeviceId(), HEX);
+  LOG_I("Fabricante HDC1080 ID: %X", hdc1080.readManufacturerId());
+  LOG_I("Dispositivo HDC1080 ID: %X", hdc1080.readDeviceId());
 
   // --- Inicializa LoRa ---
   setupBoards();
@@ -74,7 +185,8 @@ void setup()
   LoRa.setPins(RADIO_CS_PIN, RADIO_RST_PIN, RADIO_DIO0_PIN);
   if (!LoRa.begin(CONFIG_RADIO_FREQ * 1000000))
   {
-    Serial.println("Error al iniciar LoRa!");
+    LOG_E("Error al iniciar LoRa!");
+    AsyncLog::flush();
     while (1)
       ;
   }
@@ -84,7 +196,9 @@ void setup()
   LoRa.setCodingRate4(7);
   LoRa.setSyncWord(0xAB);
 
-  Serial.println("LoRa, GPS y HDC1080 listos!");
+  LOG_I("LoRa, GPS y HDC1080 listos!");
+
+  abrirEscucha();
 }
 
 // -------------------------------------------------------------------
@@ -107,17 +221,18 @@ bool leerGPS(float &lat, float &lng)
 // -------------------------------------------------------------------
 void loop()
 {
-  float lat = 0, lng = 0;
-  double temp = hdc1080.readTemperature();
-  double hum = hdc1080.readHumidity();
+  atenderCanal();
 
   if (millis() - lastSend > 3000)
-  { // cada 1 segundo
+  { // cada 3 segundos
     lastSend = millis();
+    float lat = 0, lng = 0;
+    double temp = hdc1080.readTemperature();
+    double hum = hdc1080.readHumidity();
 
     if (leerGPS(lat, lng))
     {
-      Serial.printf("GPS: %.6f, %.6f | Temp: %.2f °C | Hum: %.2f %%\n", lat, lng, temp, hum);
+      LOG_I("GPS: %.6f, %.6f | Temp: %.2f °C | Hum: %.2f %%", lat, lng, temp, hum);
 
       // Construir JSON manualmente (sin librerías) con metadatos según el formato solicitado
       // Aumentamos el buffer para tener margen suficiente
@@ -143,22 +258,32 @@ void loop()
       if (written < 0 || written >= (int)sizeof(packetBuf))
       {
         // manejar error (por ejemplo truncar o no enviar)
-        Serial.println("Packet JSON too large, not sent");
+        LOG_W("Packet JSON too large, not sent");
       }
       else
       {
-        // Enviar por LoRa
+        // Enviar por LoRa; durante una ventana de escucha el paquete va al
+        // canal de datos y la radio vuelve al de encuentro
+        bool saltar = escuchando && canalDatos >= 0;
+        if (saltar)
+        {
+          sintonizar(channel_plan[canalDatos]);
+        }
         LoRa.beginPacket();
         LoRa.print(packetBuf);
         LoRa.endPacket();
-        Serial.printf("Enviado por LoRa: #%d\n", counter);
+        if (saltar)
+        {
+          sintonizar(RENDEZVOUS_FREQ_MHZ);
+        }
+        LOG_D("Enviado por LoRa: #%d", counter);
       }
       
       counter++;
     }
     else
     {
-      Serial.println("Esperando señal GPS...");
+      LOG_I("Esperando señal GPS...");
     }
   }
 }
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <LoRa.h>
+
+namespace LoRaRx {
+
+// SX127x register map entries used by the burst reader and CAD poller.
+constexpr uint8_t kRegFifo = 0x00;
+constexpr uint8_t kRegIrqFlags = 0x12;
+constexpr uint8_t kIrqCadDetected = 0x01;
+constexpr uint8_t kIrqCadDone = 0x04;
+
+// The SX127x FIFO holds at most 255 payload bytes per packet.
+constexpr size_t kMaxPayload = 255;
+
+// SX127x SPI is rated up to 10 MHz; the LoRa library defaults to 8 MHz.
+constexpr uint32_t kSpiFrequency = 10000000;
+
+struct Packet {
+  uint8_t data[kMaxPayload + 1];  // +1 keeps text payloads NUL terminated
+  size_t length;
+  int rssi;                       // dBm
+  float snr;                      // dB
+  long frequencyError;            // Hz
+  uint32_t receivedAtMs;          // millis() when the packet was drained
+  bool inUse;
+
+  const char *c_str() const { return reinterpret_cast<const char *>(data); }
+};
+
+// Fixed set of packet slots allocated once at startup so long-running
+// receivers never touch the heap per packet.
+template <size_t N>
+class PacketPool {
+public:
+  Packet *acquire() {
+    for (size_t i = 0; i < N; ++i) {
+      if (!slots_[i].inUse) {
+        slots_[i].inUse = true;
+        slots_[i].length = 0;
+        return &slots_[i];
+      }
+    }
+    ++exhausted_;
+    return nullptr;
+  }
+
+  void release(Packet *packet) {
+    if (packet) {
+      packet->inUse = false;
+    }
+  }
+
+  uint32_t exhausted() const { return exhausted_; }
+
+private:
+  Packet slots_[N] = {};
+  uint32_t exhausted_ = 0;
+};
+
+// The clock the library runs the radio SPI at; the direct register and FIFO
+// accesses below use the same one.
+inline uint32_t &spiFrequency() {
+  static uint32_t frequency = static_cast<uint32_t>(LORA_DEFAULT_SPI_FREQUENCY);
+  return frequency;
+}
+
+inline SPISettings spiSettings() {
+  return SPISettings(spiFrequency(), MSBFIRST, SPI_MODE0);
+}
+
+// Raise the radio SPI clock. Call before LoRa.begin().
+inline void configureSpi(uint32_t frequency = kSpiFrequency) {
+  spiFrequency() = frequency;
+  LoRa.setSPIFrequency(frequency);
+}
+
+inline uint8_t readRegister(uint8_t csPin, uint8_t address) {
+  SPI.beginTransaction(spiSettings());
+  digitalWrite(csPin, LOW);
+  SPI.transfer(address & 0x7F);
+  uint8_t value = SPI.transfer(0x00);
+  digitalWrite(csPin, HIGH);
+  SPI.endTransaction();
+  return value;
+}
+
+inline void writeRegister(uint8_t csPin, uint8_t address, uint8_t value) {
+  SPI.beginTransaction(spiSettings());
+  digitalWrite(csPin, LOW);
+  SPI.transfer(address | 0x80);
+  SPI.transfer(value);
+  digitalWrite(csPin, HIGH);
+  SPI.endTransaction();
+}
+
+// Run one channel-activity detection and poll for CadDone instead of using
+// the library's DIO0 interrupt. Returns true when a preamble was seen.
+inline bool channelActivity(uint8_t csPin, uint32_t timeoutMs = 10) {
+  writeRegister(csPin, kRegIrqFlags, kIrqCadDone | kIrqCadDetected);
+  LoRa.channelActivityDetection();
+
+  uint32_t start = millis();
+  uint8_t flags = 0;
+  while (((flags = readRegister(csPin, kRegIrqFlags)) & kIrqCadDone) == 0) {
+    if (millis() - start >= timeoutMs) {
+      LoRa.idle();
+      return false;
+    }
+  }
+  writeRegister(csPin, kRegIrqFlags, kIrqCadDone | kIrqCadDetected);
+  return (flags & kIrqCadDetected) != 0;
+}
+
+// Drain the packet announced by LoRa.parsePacket() in a single SPI
+// transaction. parsePacket() has already pointed the FIFO address at the
+// start of the packet, so the whole payload is one burst read of REG_FIFO.
+// The library's own read index is not advanced: afterwards LoRa.available()
+// still reports the whole packet and LoRa.read() would read past it, so use
+// one path or the other for a given packet, never both.
+inline bool readPacket(int packetSize, uint8_t csPin, Packet &packet) {
+  if (packetSize <= 0) {
+    return false;
+  }
+
+  size_t len = min(static_cast<size_t>(packetSize), kMaxPayload);
+  memset(packet.data, 0, len + 1);
+
+  SPI.beginTransaction(spiSettings());
+  digitalWrite(csPin, LOW);
+  SPI.transfer(kRegFifo & 0x7F);
+  SPI.transfer(packet.data, len);
+  digitalWrite(csPin, HIGH);
+  SPI.endTransaction();
+
+  packet.data[len] = '\0';
+  packet.length = len;
+  packet.rssi = LoRa.packetRssi();
+  packet.snr = LoRa.packetSnr();
+  packet.frequencyError = LoRa.packetFrequencyError();
+  packet.receivedAtMs = millis();
+  return true;
+}
+
+}  // namespace LoRaRx
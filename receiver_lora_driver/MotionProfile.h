@@ -0,0 +1,206 @@
+#pragma once
+#include <stdint.h>
+
+// Jerk-limited (S-curve) speed profile for one motor, stepped once per ramp
+// tick with integer math only.
+//
+// A change of speed is a segment shaped by kSCurve: acceleration rises
+// linearly to its peak at mid-segment and falls back to zero (constant
+// jerk, peak acceleration twice the average), so the track neither lurches
+// into motion nor slams to a halt. The segment length scales with the size
+// of the change: accelTicks for a full-scale speed-up, decelTicks for a
+// full-scale slow-down. A reversal is a slow-down to zero followed by a
+// speed-up, each with its own limit. A new target mid-segment that keeps
+// the direction of travel carries the current rate into the new segment
+// (streamed setpoints would crawl if each one restarted from rest); any
+// other new target starts a new segment from the current speed.
+//
+// No Arduino dependency, so it can be exercised on the host.
+namespace MotionProfileCurve {
+
+constexpr uint32_t kPoints = 64;       // table intervals
+constexpr uint32_t kOne = 65535;       // Q16-ish full scale
+
+// Fraction of the change completed at x = i / kPoints.
+constexpr uint16_t sCurveAt(uint32_t i) {
+  return i <= kPoints / 2
+             ? static_cast<uint16_t>((2 * i * i * kOne) / (kPoints * kPoints))
+             : static_cast<uint16_t>(kOne - (2 * (kPoints - i) * (kPoints - i) * kOne) /
+                                                (kPoints * kPoints));
+}
+
+constexpr uint16_t kSCurve[kPoints + 1] = {
+    0, 31, 127, 287, 511, 799, 1151, 1567,
+    2047, 2591, 3199, 3871, 4607, 5407, 6271, 7199,
+    8191, 9247, 10367, 11551, 12799, 14111, 15487, 16927,
+    18431, 19999, 21631, 23327, 25087, 26911, 28799, 30751,
+    32767, 34784, 36736, 38624, 40448, 42208, 43904, 45536,
+    47104, 48608, 50048, 51424, 52736, 53984, 55168, 56288,
+    57344, 58336, 59264, 60128, 60928, 61664, 62336, 62944,
+    63488, 63968, 64384, 64736, 65024, 65248, 65408, 65504,
+    65535,
+};
+
+constexpr bool tableMatches(uint32_t i) {
+  return i > kPoints || (kSCurve[i] == sCurveAt(i) && tableMatches(i + 1));
+}
+
+constexpr bool tableMonotonic(uint32_t i) {
+  return i >= kPoints || (kSCurve[i] <= kSCurve[i + 1] && tableMonotonic(i + 1));
+}
+
+// The table is the curve, starts at rest, ends at the target, never steps
+// backwards and is point-symmetric about the middle.
+static_assert(tableMatches(0), "kSCurve does not match sCurveAt()");
+static_assert(tableMonotonic(0), "kSCurve must be non-decreasing");
+static_assert(kSCurve[0] == 0 && kSCurve[kPoints] == kOne, "kSCurve endpoints");
+static_assert(kSCurve[kPoints / 4] + kSCurve[3 * kPoints / 4] == kOne, "kSCurve must be symmetric");
+
+// Fraction (0..kOne) at tick of ticks, interpolated between table points.
+inline uint32_t fractionAt(uint32_t tick, uint32_t ticks) {
+  if (tick >= ticks) {
+    return kOne;
+  }
+  const uint32_t position =
+      static_cast<uint32_t>((static_cast<uint64_t>(tick) * kPoints << 8) / ticks);
+  const uint32_t index = position >> 8;
+  const uint32_t fraction = position & 0xFF;
+  return kSCurve[index] + (((kSCurve[index + 1] - kSCurve[index]) * fraction) >> 8);
+}
+
+}  // namespace MotionProfileCurve
+
+class MotionProfile {
+public:
+  // fullScale is the largest |value|; the tick counts are for a change of
+  // fullScale (at least 1).
+  void configure(int32_t fullScale, uint16_t accelTicks, uint16_t decelTicks) {
+    fullScale_ = fullScale > 0 ? fullScale : 1;
+    accelTicks_ = accelTicks ? accelTicks : 1;
+    decelTicks_ = decelTicks ? decelTicks : 1;
+    if (value_ != target_) {
+      startSegment_();
+    }
+  }
+
+  void setTarget(int32_t target) {
+    if (target == target_) {
+      return;
+    }
+    target_ = target;
+    if (!continueSegment_()) {
+      startSegment_();
+    }
+  }
+
+  // One tick; returns the new value.
+  int32_t step() {
+    if (value_ == target_) {
+      return value_;
+    }
+    ++segmentTick_;
+    const uint32_t fraction = MotionProfileCurve::fractionAt(segmentTick_, segmentTicks_);
+    const int64_t change = static_cast<int64_t>(segmentEnd_) - segmentStart_;
+    const int32_t next =
+        segmentStart_ + static_cast<int32_t>(change * fraction / MotionProfileCurve::kOne);
+    // A continued segment's virtual start may round its first value a unit
+    // behind the current one; never step backwards.
+    if (change > 0 ? next > value_ : next < value_) {
+      value_ = next;
+    }
+    if (segmentTick_ >= segmentTicks_) {
+      value_ = segmentEnd_;
+      if (value_ != target_) {
+        startSegment_();  // second half of a reversal
+      }
+    }
+    return value_;
+  }
+
+  // Jumps straight to v (no profile), e.g. at power-up.
+  void reset(int32_t v) {
+    value_ = target_ = segmentStart_ = segmentEnd_ = v;
+    segmentTick_ = segmentTicks_ = 0;
+  }
+
+  int32_t value() const { return value_; }
+  int32_t target() const { return target_; }
+  bool settled() const { return value_ == target_; }
+  uint32_t segmentTicks() const { return segmentTicks_; }
+
+private:
+  // Retarget in the direction of travel: re-enter the curve at the phase
+  // with the current rate, on its accelerating side (the curve is point-
+  // symmetric), from a virtual start chosen so that the curve passes
+  // through the current value and ends at the new target. The rate of a
+  // segment depends only on its phase and tick limit, not on its length,
+  // so the speed carries on smoothly. Returns false when a new segment is
+  // needed instead.
+  bool continueSegment_() {
+    if (segmentTick_ == 0 || segmentTick_ >= segmentTicks_) {
+      return false;
+    }
+    const bool reversing = (value_ > 0 && target_ < 0) || (value_ < 0 && target_ > 0);
+    if (reversing) {
+      return segmentEnd_ == 0;  // already slowing to zero: carry on
+    }
+    const int64_t heading = static_cast<int64_t>(segmentEnd_) - segmentStart_;
+    const int64_t remaining = static_cast<int64_t>(target_) - value_;
+    if (remaining == 0 || (heading > 0) != (remaining > 0)) {
+      return false;
+    }
+
+    uint32_t tick = segmentTick_;
+    if (2 * tick > segmentTicks_) {
+      tick = segmentTicks_ - tick;
+    }
+    const int32_t from = value_ < 0 ? -value_ : value_;
+    const int32_t to = target_ < 0 ? -target_ : target_;
+    const uint32_t fullTicks = to < from ? decelTicks_ : accelTicks_;
+    const uint64_t kOne = MotionProfileCurve::kOne;
+    const uint64_t distance = static_cast<uint64_t>(remaining > 0 ? remaining : -remaining);
+
+    // Length of the whole virtual segment, then the tick at the same phase.
+    const uint64_t phaseFraction = MotionProfileCurve::fractionAt(tick, segmentTicks_);
+    const uint64_t span = distance * kOne / (kOne - phaseFraction);
+    uint32_t ticks = static_cast<uint32_t>((span * fullTicks + fullScale_ - 1) / fullScale_);
+    if (ticks == 0) {
+      ticks = 1;
+    }
+    const uint32_t newTick = static_cast<uint32_t>(static_cast<uint64_t>(tick) * ticks /
+                                                   segmentTicks_);
+    const int64_t fraction = MotionProfileCurve::fractionAt(newTick, ticks);
+    segmentStart_ = value_ - static_cast<int32_t>(remaining * fraction /
+                                                  static_cast<int64_t>(kOne - fraction));
+    segmentEnd_ = target_;
+    segmentTicks_ = ticks;
+    segmentTick_ = newTick;
+    return true;
+  }
+
+  void startSegment_() {
+    segmentStart_ = value_;
+    const bool reversing = (value_ > 0 && target_ < 0) || (value_ < 0 && target_ > 0);
+    segmentEnd_ = reversing ? 0 : target_;
+    const int32_t from = segmentStart_ < 0 ? -segmentStart_ : segmentStart_;
+    const int32_t to = segmentEnd_ < 0 ? -segmentEnd_ : segmentEnd_;
+    const uint32_t fullTicks = to < from ? decelTicks_ : accelTicks_;
+    const uint32_t change = static_cast<uint32_t>(to > from ? to - from : from - to);
+    const uint64_t scaled = static_cast<uint64_t>(change) * fullTicks + fullScale_ - 1;
+    segmentTicks_ = static_cast<uint32_t>(scaled / fullScale_);
+    if (segmentTicks_ == 0) {
+      segmentTicks_ = 1;
+    }
+    segmentTick_ = 0;
+  }
+
+  int32_t fullScale_ = 255;
+  uint16_t accelTicks_ = 1;
+  uint16_t decelTicks_ = 1;
+  int32_t value_ = 0;
+  int32_t target_ = 0;
+  int32_t segmentStart_ = 0;
+  int32_t segmentEnd_ = 0;
+  uint32_t segmentTick_ = 0;
+  uint32_t segmentTicks_ = 0;
+};
@@ -5,54 +5,90 @@ Tank::Tank(uint8_t leftIn1, uint8_t leftIn2, uint8_t leftPwm,
     : leftIn1_(leftIn1), leftIn2_(leftIn2), leftPwm_(leftPwm),
       rightIn1_(rightIn1), rightIn2_(rightIn2), rightPwm_(rightPwm) {}
 
-void Tank::begin() {
+void Tank::begin(uint32_t pwmFrequencyHz, uint8_t pwmResolutionBits) {
+  pwmFrequencyHz_ = pwmFrequencyHz == 0 ? kDefaultPwmFrequencyHz : pwmFrequencyHz;
+  pwmResolutionBits_ = constrain(pwmResolutionBits, static_cast<uint8_t>(1), static_cast<uint8_t>(16));
+  while (pwmResolutionBits_ > 1 &&
+         (static_cast<uint64_t>(pwmFrequencyHz_) << pwmResolutionBits_) > 80000000ULL) {
+    --pwmResolutionBits_;
+  }
+  maxDuty_ = (1 << pwmResolutionBits_) - 1;
+
   pinMode(leftIn1_, OUTPUT);
   pinMode(leftIn2_, OUTPUT);
-  pinMode(leftPwm_, OUTPUT);
   pinMode(rightIn1_, OUTPUT);
   pinMode(rightIn2_, OUTPUT);
-  pinMode(rightPwm_, OUTPUT);
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcAttachChannel(leftPwm_, pwmFrequencyHz_, pwmResolutionBits_, kLeftPwmChannel);
+  ledcAttachChannel(rightPwm_, pwmFrequencyHz_, pwmResolutionBits_, kRightPwmChannel);
+#else
+  ledcSetup(kLeftPwmChannel, pwmFrequencyHz_, pwmResolutionBits_);
+  ledcSetup(kRightPwmChannel, pwmFrequencyHz_, pwmResolutionBits_);
+  ledcAttachPin(leftPwm_, kLeftPwmChannel);
+  ledcAttachPin(rightPwm_, kRightPwmChannel);
+#endif
 
   // Ensure all lines start low to keep the motors idle.
-  digitalWrite(leftIn1_, LOW);
-  digitalWrite(leftIn2_, LOW);
-  analogWrite(leftPwm_, 0);
-  digitalWrite(rightIn1_, LOW);
-  digitalWrite(rightIn2_, LOW);
-  analogWrite(rightPwm_, 0);
-
-  currentLeftCommand_ = 0;
-  currentRightCommand_ = 0;
-  targetLeftCommand_ = 0;
-  targetRightCommand_ = 0;
-  targetLeftDir_ = 0;
-  targetRightDir_ = 0;
-  lastUpdateMs_ = millis();
+  leftProfile_.reset(0);
+  rightProfile_.reset(0);
+  profileChanged_ = true;
+  apply_(0, 0);
   stop();
+  lastUpdateMs_ = millis();
+
+  // The ramp runs on its own periodic timer so its rate does not depend on
+  // how busy loop() is. Ticks missed while the CPU is in light sleep are
+  // skipped rather than replayed.
+  if (!rampTimer_) {
+    esp_timer_create_args_t args = {};
+    args.callback = &Tank::rampTimerFired_;
+    args.arg = this;
+    args.name = "tank_ramp";
+    args.skip_unhandled_events = true;
+    if (esp_timer_create(&args, &rampTimer_) != ESP_OK) {
+      rampTimer_ = nullptr;
+    }
+  }
+  if (rampTimer_) {
+    esp_timer_stop(rampTimer_);
+    esp_timer_start_periodic(rampTimer_, static_cast<uint64_t>(rampIntervalMs_) * 1000);
+  }
 }
 
 void Tank::setSpeed(uint8_t leftSpeed, uint8_t rightSpeed) {
-  maxLeftSpeed_ = constrain(leftSpeed, static_cast<uint8_t>(0), static_cast<uint8_t>(255));
-  maxRightSpeed_ = constrain(rightSpeed, static_cast<uint8_t>(0), static_cast<uint8_t>(255));
-  targetLeftCommand_ = targetLeftDir_ * static_cast<int>(maxLeftSpeed_);
-  targetRightCommand_ = targetRightDir_ * static_cast<int>(maxRightSpeed_);
+  portENTER_CRITICAL(&lock_);
+  maxLeftSpeed_ = leftSpeed;
+  maxRightSpeed_ = rightSpeed;
+  setTargets_();
+  portEXIT_CRITICAL(&lock_);
   lastUpdateMs_ = millis() - rampIntervalMs_;
 }
 
 void Tank::setDir_(int leftDir, int rightDir) {
+  portENTER_CRITICAL(&lock_);
   targetLeftDir_ = constrain(leftDir, -1, 1);
   targetRightDir_ = constrain(rightDir, -1, 1);
-  targetLeftCommand_ = targetLeftDir_ * static_cast<int>(maxLeftSpeed_);
-  targetRightCommand_ = targetRightDir_ * static_cast<int>(maxRightSpeed_);
+  setTargets_();
+  portEXIT_CRITICAL(&lock_);
   lastUpdateMs_ = millis() - rampIntervalMs_;
 }
 
-void Tank::apply_() {
-  drive_(leftIn1_, leftIn2_, leftPwm_, currentLeftCommand_);
-  drive_(rightIn1_, rightIn2_, rightPwm_, currentRightCommand_);
+// Called with lock_ held.
+void Tank::setTargets_() {
+  targetLeftCommand_ = targetLeftDir_ * toDuty_(maxLeftSpeed_);
+  targetRightCommand_ = targetRightDir_ * toDuty_(maxRightSpeed_);
+}
+
+int Tank::toDuty_(uint8_t speed) const {
+  return (static_cast<int>(speed) * maxDuty_ + 127) / 255;
+}
+
+void Tank::apply_(int leftCommand, int rightCommand) {
+  drive_(leftIn1_, leftIn2_, leftPwm_, kLeftPwmChannel, leftCommand);
+  drive_(rightIn1_, rightIn2_, rightPwm_, kRightPwmChannel, rightCommand);
 }
 
-void Tank::drive_(uint8_t in1, uint8_t in2, uint8_t pwmPin, int command) const {
+void Tank::drive_(uint8_t in1, uint8_t in2, uint8_t pwmPin, uint8_t channel, int command) const {
   if (command > 0) {
     digitalWrite(in1, HIGH);
     digitalWrite(in2, LOW);
@@ -64,8 +100,14 @@ void Tank::drive_(uint8_t in1, uint8_t in2, uint8_t pwmPin, int command) const {
     digitalWrite(in2, LOW);
   }
 
-  uint8_t pwm = static_cast<uint8_t>(abs(command));
-  analogWrite(pwmPin, pwm);
+  const uint32_t duty = static_cast<uint32_t>(abs(command));
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  (void)channel;
+  ledcWrite(pwmPin, duty);
+#else
+  (void)pwmPin;
+  ledcWrite(channel, duty);
+#endif
 }
 
 void Tank::forward() {
@@ -93,79 +135,112 @@ void Tank::stop() {
   last_ = TankState::STOP;
 }
 
-void Tank::setRamp(uint8_t step, uint16_t intervalMs) {
-  rampStep_ = step == 0 ? 1 : step;
+void Tank::setProfile(uint16_t leftAccelMs, uint16_t leftDecelMs,
+                      uint16_t rightAccelMs, uint16_t rightDecelMs) {
+  portENTER_CRITICAL(&lock_);
+  leftAccelMs_ = leftAccelMs;
+  leftDecelMs_ = leftDecelMs;
+  rightAccelMs_ = rightAccelMs;
+  rightDecelMs_ = rightDecelMs;
+  profileChanged_ = true;
+  portEXIT_CRITICAL(&lock_);
+}
+
+void Tank::setRampInterval(uint16_t intervalMs) {
+  if (rampTimer_) {
+    esp_timer_stop(rampTimer_);
+  }
+  portENTER_CRITICAL(&lock_);
   rampIntervalMs_ = intervalMs == 0 ? 1 : intervalMs;
+  profileChanged_ = true;
+  lastTickUs_ = 0;
+  portEXIT_CRITICAL(&lock_);
   lastUpdateMs_ = millis() - rampIntervalMs_;
+  if (rampTimer_) {
+    esp_timer_start_periodic(rampTimer_, static_cast<uint64_t>(rampIntervalMs_) * 1000);
+  }
+}
+
+void Tank::setRamp(uint8_t step, uint16_t intervalMs) {
+  setRampInterval(intervalMs);
+  const int stepSize = step == 0 ? 1 : step;
+  const uint16_t fullSwingMs = static_cast<uint16_t>((255 + stepSize - 1) / stepSize * rampIntervalMs_);
+  setProfile(fullSwingMs, fullSwingMs, fullSwingMs, fullSwingMs);
 }
 
 void Tank::update() {
+  if (rampTimer_) {
+    return;
+  }
   unsigned long now = millis();
   if (now - lastUpdateMs_ < rampIntervalMs_) {
     return;
   }
   lastUpdateMs_ = now;
+  rampTick_(esp_timer_get_time());
+}
 
-  int nextLeft = stepToward_(currentLeftCommand_, targetLeftCommand_);
-  int nextRight = stepToward_(currentRightCommand_, targetRightCommand_);
-
-  if (nextLeft == currentLeftCommand_ && nextRight == currentRightCommand_) {
-    return;
-  }
-
-  currentLeftCommand_ = nextLeft;
-  currentRightCommand_ = nextRight;
-  apply_();
+void Tank::rampTimerFired_(void *arg) {
+  static_cast<Tank *>(arg)->rampTick_(esp_timer_get_time());
 }
 
-int Tank::stepToward_(int current, int target) const {
-  if (current == target) {
-    return current;
+void Tank::rampTick_(int64_t nowUs) {
+  portENTER_CRITICAL(&lock_);
+  const int targetLeft = targetLeftCommand_;
+  const int targetRight = targetRightCommand_;
+  const bool reconfigure = profileChanged_;
+  profileChanged_ = false;
+  const uint16_t interval = rampIntervalMs_;
+  const uint16_t leftAccelTicks = max(1, leftAccelMs_ / interval);
+  const uint16_t leftDecelTicks = max(1, leftDecelMs_ / interval);
+  const uint16_t rightAccelTicks = max(1, rightAccelMs_ / interval);
+  const uint16_t rightDecelTicks = max(1, rightDecelMs_ / interval);
+  portEXIT_CRITICAL(&lock_);
+
+  if (reconfigure) {
+    leftProfile_.configure(maxDuty_, leftAccelTicks, leftDecelTicks);
+    rightProfile_.configure(maxDuty_, rightAccelTicks, rightDecelTicks);
   }
-
-  int step = static_cast<int>(rampStep_);
-
-  if (target == 0) {
-    if (current > 0) {
-      current -= step;
-      if (current < 0) {
-        current = 0;
-      }
-    } else {
-      current += step;
-      if (current > 0) {
-        current = 0;
-      }
-    }
-    return current;
+  const int previousLeft = leftProfile_.value();
+  const int previousRight = rightProfile_.value();
+  leftProfile_.setTarget(targetLeft);
+  rightProfile_.setTarget(targetRight);
+  const int nextLeft = leftProfile_.step();
+  const int nextRight = rightProfile_.step();
+
+  portENTER_CRITICAL(&lock_);
+  if (nextLeft == previousLeft && nextRight == previousRight) {
+    lastTickUs_ = 0;  // idle: the next ramp starts a fresh measurement
+    portEXIT_CRITICAL(&lock_);
+    return;
   }
-
-  if (target > 0) {
-    if (current < 0) {
-      current += step;
-      if (current > 0) {
-        current = 0;
-      }
-      return current;
+  if (lastTickUs_ != 0) {
+    const int32_t errorUs = static_cast<int32_t>(nowUs - lastTickUs_) -
+                            static_cast<int32_t>(rampIntervalMs_) * 1000;
+    if (rampIntervals_ == 0 || errorUs < minErrorUs_) {
+      minErrorUs_ = errorUs;
     }
-    current += step;
-    if (current > target) {
-      current = target;
+    if (rampIntervals_ == 0 || errorUs > maxErrorUs_) {
+      maxErrorUs_ = errorUs;
     }
-    return current;
+    sumAbsErrorUs_ += static_cast<uint32_t>(abs(errorUs));
+    ++rampIntervals_;
   }
+  lastTickUs_ = nowUs;
+  ++rampTicks_;
+  portEXIT_CRITICAL(&lock_);
 
-  // target < 0
-  if (current > 0) {
-    current -= step;
-    if (current < 0) {
-      current = 0;
-    }
-    return current;
-  }
-  current -= step;
-  if (current < target) {
-    current = target;
-  }
-  return current;
+  apply_(nextLeft, nextRight);
+}
+
+Tank::RampStats Tank::rampStats() {
+  RampStats stats;
+  portENTER_CRITICAL(&lock_);
+  stats.ticks = rampTicks_;
+  stats.intervals = rampIntervals_;
+  stats.minErrorUs = minErrorUs_;
+  stats.maxErrorUs = maxErrorUs_;
+  stats.meanAbsErrorUs = rampIntervals_ ? static_cast<uint32_t>(sumAbsErrorUs_ / rampIntervals_) : 0;
+  portEXIT_CRITICAL(&lock_);
+  return stats;
 }
@@ -1,49 +1,103 @@
 #pragma once
 #include <Arduino.h>
+#include <esp_timer.h>
+#include "MotionProfile.h"
 
 enum class TankState { STOP, FORWARD, BACKWARD, LEFT, RIGHT };
 
 class Tank {
 public:
+  // LEDC output: ultrasonic by default so the motors do not whine. The
+  // LEDC clock (80 MHz) bounds frequency * 2^bits; begin() lowers the
+  // resolution when the pair does not fit (12 bits tops out near 19.5 kHz).
+  static constexpr uint32_t kDefaultPwmFrequencyHz = 20000;
+  static constexpr uint8_t kDefaultPwmResolutionBits = 10;
+
+  // Ramp timer accuracy: the interval between consecutive ticks of a ramp
+  // in progress, minus the nominal interval.
+  struct RampStats {
+    uint32_t ticks = 0;          // ticks that moved the outputs
+    uint32_t intervals = 0;      // intervals measured
+    int32_t minErrorUs = 0;
+    int32_t maxErrorUs = 0;
+    uint32_t meanAbsErrorUs = 0;
+  };
+
   // Map each half-H bridge: IN1, IN2, PWM (ENA/ENB).
   Tank(uint8_t leftIn1, uint8_t leftIn2, uint8_t leftPwm,
        uint8_t rightIn1, uint8_t rightIn2, uint8_t rightPwm);
 
-  void begin();
+  void begin(uint32_t pwmFrequencyHz = kDefaultPwmFrequencyHz,
+             uint8_t pwmResolutionBits = kDefaultPwmResolutionBits);
   void forward();   // both motors forward
   void backward();  // both motors backward
   void left();      // spin left: left back, right forward
   void right();     // spin right: left forward, right back
   void stop();      // disable both motors (coast)
 
-  void setSpeed(uint8_t leftSpeed, uint8_t rightSpeed); // Max PWM (0-255)
+  void setSpeed(uint8_t leftSpeed, uint8_t rightSpeed); // Max speed (0-255)
   uint8_t leftSpeed()  const { return maxLeftSpeed_; }
   uint8_t rightSpeed() const { return maxRightSpeed_; }
-  void setRamp(uint8_t step, uint16_t intervalMs);      // ramp resolution
-  void update();                                        // call every loop tick
+  // Ramp shaping. Each track follows a jerk-limited S-curve (MotionProfile)
+  // whose length is set per track and direction as the time for a
+  // full-scale change (0 <-> full speed).
+  void setProfile(uint16_t leftAccelMs, uint16_t leftDecelMs,
+                  uint16_t rightAccelMs, uint16_t rightDecelMs);
+  void setRampInterval(uint16_t intervalMs);            // ramp tick period
+  void setRamp(uint8_t step, uint16_t intervalMs);      // legacy: 255/step ticks per full swing
+  void update();    // only ramps if the ramp timer could not be created
   TankState state() const { return last_; }
 
+  uint32_t pwmFrequency() const { return pwmFrequencyHz_; }
+  uint8_t pwmResolution() const { return pwmResolutionBits_; }
+  RampStats rampStats();
+
 private:
+  static void rampTimerFired_(void *arg);
+  void rampTick_(int64_t nowUs);
   void setDir_(int leftDir, int rightDir); // -1 back, 0 stop, +1 forward
-  void apply_();
-  void drive_(uint8_t in1, uint8_t in2, uint8_t pwmPin, int command) const;
-  int stepToward_(int current, int target) const;
+  void setTargets_();
+  void apply_(int leftCommand, int rightCommand);
+  void drive_(uint8_t in1, uint8_t in2, uint8_t pwmPin, uint8_t channel, int command) const;
+  int toDuty_(uint8_t speed) const;
+
+  static constexpr uint8_t kLeftPwmChannel = 0;
+  static constexpr uint8_t kRightPwmChannel = 1;
 
   uint8_t leftIn1_, leftIn2_, leftPwm_;
   uint8_t rightIn1_, rightIn2_, rightPwm_;
 
+  uint32_t pwmFrequencyHz_ = kDefaultPwmFrequencyHz;
+  uint8_t pwmResolutionBits_ = kDefaultPwmResolutionBits;
+  int maxDuty_ = (1 << kDefaultPwmResolutionBits) - 1;
+
+  // Targets are written by the caller's task and read by the ramp timer;
+  // commands are in duty counts (-maxDuty_..maxDuty_).
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
   int targetLeftDir_ = 0;
   int targetRightDir_ = 0;
-  int targetLeftCommand_ = 0;   // -255..255
-  int targetRightCommand_ = 0;  // -255..255
-  int currentLeftCommand_ = 0;  // -255..255
-  int currentRightCommand_ = 0; // -255..255
+  int targetLeftCommand_ = 0;
+  int targetRightCommand_ = 0;
+  MotionProfile leftProfile_;   // ramp timer only
+  MotionProfile rightProfile_;  // ramp timer only
 
   uint8_t maxLeftSpeed_ = 255;
   uint8_t maxRightSpeed_ = 255;
-  uint8_t rampStep_ = 8;
+  uint16_t leftAccelMs_ = 480;
+  uint16_t leftDecelMs_ = 480;
+  uint16_t rightAccelMs_ = 480;
+  uint16_t rightDecelMs_ = 480;
+  bool profileChanged_ = true;  // reconfigure the profiles on the next tick
   uint16_t rampIntervalMs_ = 15;
   unsigned long lastUpdateMs_ = 0;
 
+  esp_timer_handle_t rampTimer_ = nullptr;
+  int64_t lastTickUs_ = 0;        // previous tick that moved the outputs, 0 after idle
+  uint32_t rampTicks_ = 0;
+  uint32_t rampIntervals_ = 0;
+  int32_t minErrorUs_ = 0;
+  int32_t maxErrorUs_ = 0;
+  uint64_t sumAbsErrorUs_ = 0;
+
   TankState last_ = TankState::STOP;
 };
@@ -1,9 +1,12 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include <LoRa.h>
+#include <esp_sleep.h>
 #include "TankShift.h"
 #include "../common/ControlProtocol.h"
 #include "LoRaBoards.h"
+#include "LoRaRx.h"
+#include "AsyncLog.h"
 
 #if !defined(ESP32)
 #error "Current RX build targets the LilyGO T-Beam (ESP32)."
@@ -18,6 +21,32 @@
 #ifndef CONFIG_RADIO_BW
 #define CONFIG_RADIO_BW             125.0
 #endif
+// Radio address of this tank when one gateway drives several (matches the
+// gateway's TANK_TABLE). 0 accepts every frame, as in single-tank setups.
+#ifndef TANK_RADIO_ADDRESS
+#define TANK_RADIO_ADDRESS          0
+#endif
+// Motor PWM (LEDC): above the audible range, 10-12 bits of duty resolution.
+#ifndef MOTOR_PWM_FREQ_HZ
+#define MOTOR_PWM_FREQ_HZ           20000
+#endif
+#ifndef MOTOR_PWM_RESOLUTION_BITS
+#define MOTOR_PWM_RESOLUTION_BITS   10
+#endif
+// S-curve ramp: ms for a full-scale change (stop <-> full speed), per track.
+// Slowing down is quicker than speeding up so Stop stays responsive.
+#ifndef MOTOR_LEFT_ACCEL_MS
+#define MOTOR_LEFT_ACCEL_MS         300
+#endif
+#ifndef MOTOR_LEFT_DECEL_MS
+#define MOTOR_LEFT_DECEL_MS         200
+#endif
+#ifndef MOTOR_RIGHT_ACCEL_MS
+#define MOTOR_RIGHT_ACCEL_MS        MOTOR_LEFT_ACCEL_MS
+#endif
+#ifndef MOTOR_RIGHT_DECEL_MS
+#define MOTOR_RIGHT_DECEL_MS        MOTOR_LEFT_DECEL_MS
+#endif
 
 // ---------- L298N Half-H bridge pin mapping for LilyGO T-Beam ----------
 // Avoid LoRa DIO lines (GPIO32/33) which are wired to the SX1276 module.
@@ -37,29 +66,53 @@ uint8_t expectedSequence = 0;
 bool hasSequence = false;
 unsigned long lastFrameTimestamp = 0;
 
+// Link-loss watchdog: armed while a LoRa motion command drives the tank,
+// so a dead link ramps it to a stop after kLinkTimeoutMs instead of
+// leaving it on its last command. Serial control disarms it.
+bool watchdogArmed = false;
+uint32_t watchdogStops = 0;
+
 TankControl::ControlFrame lastFrame{};
+LoRaRx::PacketPool<2> rxPool;
+
+// Data channel announced by the gateway; until then (and whenever the link
+// goes quiet) listen on the rendezvous frequency.
+bool onRendezvous = true;
+uint8_t dataChannel = 0;
+
+// ---------- Parked mode (CAD duty cycle + light sleep) ----------
+struct ParkedStats {
+  bool active = false;
+  uint32_t enteredAtMs = 0;
+  uint32_t lastClearCadMs = 0;   // end of the last CAD that saw an idle channel
+  uint32_t cadChecks = 0;
+  uint32_t falseWakes = 0;       // CAD hit without a valid frame following it
+  float awakeCurrentMa = 0.0f;   // battery discharge right before parking
+  float idleCurrentSumMa = 0.0f;
+  uint32_t idleCurrentSamples = 0;
+  uint32_t lastWakeLatencyMs = 0;
+  uint32_t maxWakeLatencyMs = 0;
+};
+
+ParkedStats parked;
+
+// Wake preamble plus the frame behind it, at ~1 ms per symbol (SF7/125 kHz).
+constexpr uint32_t kWakeListenMs = TankControl::kWakePreambleSymbols + 64;
 
 void logState(const char *label) {
-  Serial.print(label);
-  Serial.print(" | cmd=");
-  Serial.print(static_cast<int>(lastFrame.command));
-  Serial.print(" seq=");
-  Serial.print(lastFrame.sequence);
-  Serial.print(" left=");
-  Serial.print(lastFrame.leftSpeed);
-  Serial.print(" right=");
-  Serial.println(lastFrame.rightSpeed);
+  LOG_D("%s | cmd=%d seq=%u left=%u right=%u", label, static_cast<int>(lastFrame.command),
+        lastFrame.sequence, lastFrame.leftSpeed, lastFrame.rightSpeed);
 }
 
 void handleKey(int c) {
   if (escStage == 0) {
     if (c == 0x1B) { escStage = 1; return; }  // ESC
-    if (c == ' ')  { Tank.stop(); Serial.println("STOP"); return; }
+    if (c == ' ')  { Tank.stop(); LOG_I("STOP"); return; }
     // WASD fallback
-    if (c == 'w' || c == 'W') { Tank.forward();  Serial.println("FORWARD"); }
-    if (c == 's' || c == 'S') { Tank.backward(); Serial.println("BACKWARD"); }
-    if (c == 'a' || c == 'A') { Tank.left();     Serial.println("LEFT"); }
-    if (c == 'd' || c == 'D') { Tank.right();    Serial.println("RIGHT"); }
+    if (c == 'w' || c == 'W') { Tank.forward();  LOG_I("FORWARD"); }
+    if (c == 's' || c == 'S') { Tank.backward(); LOG_I("BACKWARD"); }
+    if (c == 'a' || c == 'A') { Tank.left();     LOG_I("LEFT"); }
+    if (c == 'd' || c == 'D') { Tank.right();    LOG_I("RIGHT"); }
     return;
   }
   if (escStage == 1) {
@@ -68,22 +121,176 @@ void handleKey(int c) {
   }
   if (escStage == 2) {
     switch (c) {
-      case 'A': Tank.forward();  Serial.println("FORWARD");  break; // Up
-      case 'B': Tank.backward(); Serial.println("BACKWARD"); break; // Down
-      case 'C': Tank.right();    Serial.println("RIGHT");    break; // Right
-      case 'D': Tank.left();     Serial.println("LEFT");     break; // Left
+      case 'A': Tank.forward();  LOG_I("FORWARD");  break; // Up
+      case 'B': Tank.backward(); LOG_I("BACKWARD"); break; // Down
+      case 'C': Tank.right();    LOG_I("RIGHT");    break; // Right
+      case 'D': Tank.left();     LOG_I("LEFT");     break; // Left
       default: break;
     }
     escStage = 0;
   }
 }
 
+// Ramp timer accuracy, logged after motion at most every 30 s.
+void logRampJitter() {
+  static uint32_t lastLogAt = 0;
+  static uint32_t loggedIntervals = 0;
+  if (millis() - lastLogAt < 30000) {
+    return;
+  }
+  lastLogAt = millis();
+  const auto stats = Tank.rampStats();
+  if (stats.intervals == loggedIntervals) {
+    return;
+  }
+  loggedIntervals = stats.intervals;
+  LOG_I("Ramp timer | ticks=%lu intervals=%lu error min=%ldus max=%ldus mean|e|=%luus",
+        static_cast<unsigned long>(stats.ticks), static_cast<unsigned long>(stats.intervals),
+        static_cast<long>(stats.minErrorUs), static_cast<long>(stats.maxErrorUs),
+        static_cast<unsigned long>(stats.meanAbsErrorUs));
+}
+
+void tuneRadio(float frequencyMHz) {
+  LoRa.idle();
+  LoRa.setFrequency(static_cast<long>(frequencyMHz * 1000000));
+  LoRa.receive();
+}
+
+void tuneDataChannel(uint8_t channel) {
+  if (channel >= TankControl::kChannelCount) {
+    LOG_W("LoRa channel announce ignored: unknown channel");
+    return;
+  }
+  dataChannel = channel;
+  onRendezvous = false;
+  tuneRadio(TankControl::kChannelPlanMHz[channel]);
+  LOG_I("LoRa -> data channel %u (%.1f MHz)", channel,
+        TankControl::kChannelPlanMHz[channel]);
+}
+
+void tuneRendezvous() {
+  if (onRendezvous) {
+    return;
+  }
+  onRendezvous = true;
+  tuneRadio(TankControl::kRendezvousMHz);
+  LOG_I("LoRa link quiet -> rendezvous %.1f MHz", TankControl::kRendezvousMHz);
+}
+
+// Battery discharge current from the AXP192 ADC. The AXP2101 on newer
+// T-Beams has no current ADC, so the reading is reported as unavailable.
+bool readBatteryCurrent(float &milliamps) {
+#ifdef HAS_PMU
+  if (PMU && PMU->getChipModel() == XPOWERS_AXP192 && !PMU->isVbusIn()) {
+    milliamps = static_cast<XPowersAXP192 *>(PMU)->getBattDischargeCurrent();
+    return true;
+  }
+#endif
+  return false;
+}
+
+uint16_t readBatteryMillivolts() {
+#ifdef HAS_PMU
+  if (PMU) {
+    return PMU->getBattVoltage();
+  }
+#endif
+  return 0;
+}
+
+void logParkedReport() {
+  uint32_t parkedSeconds = (millis() - parked.enteredAtMs) / 1000;
+  char current[48];
+  if (parked.idleCurrentSamples > 0) {
+    snprintf(current, sizeof(current), "idle=%.1fmA awake=%.1fmA",
+             parked.idleCurrentSumMa / parked.idleCurrentSamples, parked.awakeCurrentMa);
+  } else {
+    snprintf(current, sizeof(current), "idle=n/a (no AXP192 or on USB power)");
+  }
+  LOG_I("PARKED report | %lus cad=%lu falseWakes=%lu battery=%umV %s"
+        " wake last=%lums max=%lums bound=%lums",
+        static_cast<unsigned long>(parkedSeconds),
+        static_cast<unsigned long>(parked.cadChecks),
+        static_cast<unsigned long>(parked.falseWakes),
+        readBatteryMillivolts(), current,
+        static_cast<unsigned long>(parked.lastWakeLatencyMs),
+        static_cast<unsigned long>(parked.maxWakeLatencyMs),
+        static_cast<unsigned long>(TankControl::kCadPeriodMs + kWakeListenMs));
+}
+
+void enterParkedMode() {
+  tuneRendezvous();
+  parked = ParkedStats{};
+  parked.active = true;
+  parked.enteredAtMs = millis();
+  parked.lastClearCadMs = parked.enteredAtMs;
+  readBatteryCurrent(parked.awakeCurrentMa);
+
+  LoRa.setPreambleLength(TankControl::kWakePreambleSymbols);
+  LOG_I("Link idle -> PARKED (CAD duty cycle)");
+  AsyncLog::flush();
+  Serial.flush();
+}
+
+void leaveParkedMode(bool viaRadio) {
+  if (viaRadio) {
+    uint32_t latency = millis() - parked.lastClearCadMs;
+    parked.lastWakeLatencyMs = latency;
+    if (latency > parked.maxWakeLatencyMs) {
+      parked.maxWakeLatencyMs = latency;
+    }
+  }
+  parked.active = false;
+  lastFrameTimestamp = millis();
+
+  LoRa.setPreambleLength(TankControl::kLinkPreambleSymbols);
+  logParkedReport();
+}
+
+bool handleLoRa();
+
+// One parked cycle: sleep the radio and the CPU for a CAD period, run a CAD
+// and, on activity, listen long enough to catch the wake frame behind it.
+void parkedTick() {
+  LoRa.sleep();
+  AsyncLog::flush();  // the drain task cannot run during light sleep
+  Serial.flush();
+  esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(TankControl::kCadPeriodMs) * 1000ULL);
+  esp_light_sleep_start();
+
+  float milliamps = 0.0f;
+  if (readBatteryCurrent(milliamps)) {
+    parked.idleCurrentSumMa += milliamps;
+    ++parked.idleCurrentSamples;
+  }
+
+  LoRa.idle();
+  ++parked.cadChecks;
+  if (!LoRaRx::channelActivity(RADIO_CS_PIN)) {
+    parked.lastClearCadMs = millis();
+    return;
+  }
+
+  uint32_t start = millis();
+  while (millis() - start < kWakeListenMs) {
+    if (handleLoRa()) {
+      return;
+    }
+  }
+  ++parked.falseWakes;
+  parked.lastClearCadMs = millis();
+}
+
 void applyCommand(const TankControl::ControlFrame &frame) {
   lastFrame = frame;
   lastFrameTimestamp = millis();
   Tank.setSpeed(frame.leftSpeed, frame.rightSpeed);
 
-  switch (TankControl::commandFromFrame(frame)) {
+  const TankControl::Command command = TankControl::commandFromFrame(frame);
+  if (command != TankControl::Command::SetSpeed) {
+    watchdogArmed = TankControl::isMotion(command);
+  }
+  switch (command) {
     case TankControl::Command::Stop:
       Tank.stop();
       logState("LoRa -> STOP");
@@ -114,53 +321,77 @@ void applyCommand(const TankControl::ControlFrame &frame) {
   }
 }
 
-void handleLoRa() {
-  int packetSize = LoRa.parsePacket();
+// Returns true when a valid frame was applied.
+bool handleLoRa() {
+  int packetSize = LoRa.parsePacket(TankControl::kImplicitHeader ? TankControl::kFrameSize : 0);
   if (packetSize <= 0) {
-    return;
+    return false;
   }
 
-  uint8_t buffer[TankControl::kFrameSize];
-  int len = min(packetSize, static_cast<int>(sizeof(buffer)));
-  for (int i = 0; i < len; ++i) {
-    buffer[i] = static_cast<uint8_t>(LoRa.read());
-  }
-  while (LoRa.available()) {
-    LoRa.read();
+  LoRaRx::Packet *packet = rxPool.acquire();
+  if (!packet) {
+    LOG_W("LoRa packet discarded: rx pool exhausted");
+    return false;
   }
+  LoRaRx::readPacket(packetSize, RADIO_CS_PIN, *packet);
 
-  if (len != static_cast<int>(TankControl::kFrameSize)) {
-    Serial.println("LoRa packet discarded: unexpected length");
-    return;
+  if (packet->length != TankControl::kFrameSize) {
+    LOG_W("LoRa packet discarded: unexpected length");
+    rxPool.release(packet);
+    return false;
   }
 
   TankControl::ControlFrame frame;
-  if (!TankControl::decryptFrame(buffer, TankControl::kFrameSize, frame)) {
-    Serial.println("LoRa packet discarded: decrypt/CRC failed");
-    return;
+  bool valid = TankControl::decryptFrame(packet->data, packet->length, frame);
+  rxPool.release(packet);
+  if (!valid) {
+    LOG_W("LoRa packet discarded: decrypt/CRC failed");
+    return false;
+  }
+
+  if (TANK_RADIO_ADDRESS != TankControl::kBroadcastAddress &&
+      frame.address != TankControl::kBroadcastAddress &&
+      frame.address != TANK_RADIO_ADDRESS) {
+    return false;  // another tank's frame
+  }
+
+  // Channel announcements are broadcast with the gateway's own counter and
+  // are idempotent, so they stay out of the per-tank duplicate check.
+  if (TankControl::commandFromFrame(frame) == TankControl::Command::Channel) {
+    if (parked.active) {
+      leaveParkedMode(/*viaRadio=*/true);
+    }
+    lastFrameTimestamp = millis();
+    tuneDataChannel(frame.leftSpeed);
+    return true;
   }
 
   if (hasSequence && frame.sequence == expectedSequence) {
-    Serial.println("LoRa packet ignored: duplicate sequence");
-    return;
+    LOG_D("LoRa packet ignored: duplicate sequence");
+    return false;
   }
 
   expectedSequence = frame.sequence;
   hasSequence = true;
+  if (parked.active) {
+    leaveParkedMode(/*viaRadio=*/true);
+  }
   applyCommand(frame);
+  return true;
 }
 
 bool beginLoRa() {
   SPI.begin(RADIO_SCLK_PIN, RADIO_MISO_PIN, RADIO_MOSI_PIN, RADIO_CS_PIN);
   LoRa.setPins(RADIO_CS_PIN, RADIO_RST_PIN, RADIO_DIO0_PIN);
+  LoRaRx::configureSpi();
 
 #ifdef RADIO_TCXO_ENABLE
   pinMode(RADIO_TCXO_ENABLE, OUTPUT);
   digitalWrite(RADIO_TCXO_ENABLE, HIGH);
 #endif
 
-  if (!LoRa.begin(CONFIG_RADIO_FREQ * 1000000)) {
-    Serial.println("LoRa init failed. Check wiring.");
+  if (!LoRa.begin(TankControl::kRendezvousMHz * 1000000)) {
+    LOG_E("LoRa init failed. Check wiring.");
     return false;
   }
 
@@ -169,9 +400,12 @@ bool beginLoRa() {
   LoRa.setSpreadingFactor(7);
   LoRa.setCodingRate4(5);
   LoRa.enableCrc();
+  LoRa.setPreambleLength(TankControl::kLinkPreambleSymbols);
   LoRa.receive();
 
-  Serial.println("LoRa radio ready.");
+  LOG_I("LoRa radio ready.");
+  AsyncLog::flush();  // the link profile goes straight to Serial
+  TankControl::printLinkProfile(Serial, 7, CONFIG_RADIO_BW * 1000, 5);
   return true;
 }
 
@@ -180,30 +414,65 @@ void setup() {
   delay(1500); // allow PMU rails to stabilize before accessing peripherals
   Serial.begin(115200);
   while (!Serial) { delay(10); }
-  Serial.println("\nT-Beam RX | L298N Tank Controller");
-  Serial.println("LoRa listener + PWM ramp drivetrain");
-  Serial.println("Serial fallback: Arrow keys = move, Space = stop.");
+  AsyncLog::begin();
+  LOG_I("\nT-Beam RX | L298N Tank Controller");
+  LOG_I("LoRa listener + PWM ramp drivetrain");
+  LOG_I("Serial fallback: Arrow keys = move, Space = stop.");
 
-  Tank.begin();
-  Tank.setRamp(10, 10); // step size, interval ms
+  Tank.begin(MOTOR_PWM_FREQ_HZ, MOTOR_PWM_RESOLUTION_BITS);
+  Tank.setRampInterval(10);
+  Tank.setProfile(MOTOR_LEFT_ACCEL_MS, MOTOR_LEFT_DECEL_MS,
+                  MOTOR_RIGHT_ACCEL_MS, MOTOR_RIGHT_DECEL_MS);
   Tank.stop();
+  LOG_I("Motor PWM: %lu Hz, %u-bit (LEDC) | S-curve ramp accel/decel"
+        " L %u/%u ms R %u/%u ms",
+        static_cast<unsigned long>(Tank.pwmFrequency()), Tank.pwmResolution(),
+        MOTOR_LEFT_ACCEL_MS, MOTOR_LEFT_DECEL_MS, MOTOR_RIGHT_ACCEL_MS, MOTOR_RIGHT_DECEL_MS);
 
   if (!beginLoRa()) {
-    Serial.println("LoRa setup failed; continuing with serial-only control.");
+    LOG_E("LoRa setup failed; continuing with serial-only control.");
   }
 }
 
 void loop() {
   while (Serial.available()) {
     int c = Serial.read();
+    watchdogArmed = false;
     handleKey(c);
-    if (c == 'f' || c == 'F') { Tank.forward(); Serial.println("FORWARD"); }
-    if (c == 'b' || c == 'B') { Tank.backward(); Serial.println("BACKWARD"); }
-    if (c == 'l' || c == 'L') { Tank.left(); Serial.println("LEFT"); }
-    if (c == 'r' || c == 'R') { Tank.right(); Serial.println("RIGHT"); }
-    if (c == ' ')            { Tank.stop(); Serial.println("STOP"); }
+    if (c == 'f' || c == 'F') { Tank.forward(); LOG_I("FORWARD"); }
+    if (c == 'b' || c == 'B') { Tank.backward(); LOG_I("BACKWARD"); }
+    if (c == 'l' || c == 'L') { Tank.left(); LOG_I("LEFT"); }
+    if (c == 'r' || c == 'R') { Tank.right(); LOG_I("RIGHT"); }
+    if (c == ' ')            { Tank.stop(); LOG_I("STOP"); }
   }
+  if (parked.active) {
+    if (Tank.state() != TankState::STOP) {
+      leaveParkedMode(/*viaRadio=*/false);  // serial fallback took over
+    } else {
+      parkedTick();
+      return;
+    }
+  }
+
   handleLoRa();
+  if (watchdogArmed && millis() - lastFrameTimestamp >= TankControl::kLinkTimeoutMs) {
+    watchdogArmed = false;
+    ++watchdogStops;
+    Tank.stop();  // ramps down on the ramp timer
+    LOG_W("Link lost for %lu ms -> STOP (watchdog stops: %lu)",
+          static_cast<unsigned long>(millis() - lastFrameTimestamp),
+          static_cast<unsigned long>(watchdogStops));
+  }
   Tank.update();
-  delay(5); // keep the ramp timing predictable
+  logRampJitter();
+
+  if (!onRendezvous && millis() - lastFrameTimestamp >= TankControl::kRendezvousAfterIdleMs) {
+    tuneRendezvous();
+  }
+  if (Tank.state() == TankState::STOP &&
+      millis() - lastFrameTimestamp >= TankControl::kParkAfterIdleMs) {
+    enterParkedMode();
+    return;
+  }
+  delay(5);
 }
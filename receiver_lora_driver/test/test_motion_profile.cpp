@@ -0,0 +1,244 @@
+// Host test for MotionProfile (no Arduino needed): make -C receiver_lora_driver/test
+#include <cstdio>
+#include <cstdlib>
+#include "MotionProfile.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                       \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++failures;                                                         \
+    }                                                                     \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                        \
+  do {                                                                        \
+    const long long va = (a), vb = (b);                                       \
+    if (va != vb) {                                                           \
+      std::printf("%s:%d: CHECK_EQ failed: %s == %s (%lld vs %lld)\n",        \
+                  __FILE__, __LINE__, #a, #b, va, vb);                        \
+      ++failures;                                                             \
+    }                                                                         \
+  } while (0)
+
+constexpr int32_t kFullScale = 255;
+constexpr uint16_t kAccelTicks = 50;
+constexpr uint16_t kDecelTicks = 20;
+
+MotionProfile makeProfile(int32_t start) {
+  MotionProfile profile;
+  profile.configure(kFullScale, kAccelTicks, kDecelTicks);
+  profile.reset(start);
+  return profile;
+}
+
+// Steps until settled; returns the tick count (capped so a bug cannot hang).
+int runToTarget(MotionProfile &profile) {
+  int ticks = 0;
+  while (!profile.settled() && ticks < 10000) {
+    profile.step();
+    ++ticks;
+  }
+  return ticks;
+}
+
+// Steps through the current segment only, checking each value moves toward
+// the segment end and never past it. Returns the tick count.
+int runSegmentMonotonic(MotionProfile &profile, int32_t segmentEnd) {
+  const uint32_t ticks = profile.segmentTicks();
+  const int direction = segmentEnd > profile.value() ? 1 : -1;
+  int32_t previous = profile.value();
+  for (uint32_t tick = 0; tick < ticks; ++tick) {
+    const int32_t value = profile.step();
+    CHECK((value - previous) * direction >= 0);
+    CHECK((segmentEnd - value) * direction >= 0);
+    previous = value;
+  }
+  CHECK_EQ(profile.value(), segmentEnd);
+  return static_cast<int>(ticks);
+}
+
+void testFullScaleTicks() {
+  MotionProfile up = makeProfile(0);
+  up.setTarget(kFullScale);
+  CHECK_EQ(up.segmentTicks(), kAccelTicks);
+  CHECK_EQ(runToTarget(up), kAccelTicks);
+  CHECK_EQ(up.value(), kFullScale);
+
+  MotionProfile down = makeProfile(kFullScale);
+  down.setTarget(0);
+  CHECK_EQ(down.segmentTicks(), kDecelTicks);
+  CHECK_EQ(runToTarget(down), kDecelTicks);
+  CHECK_EQ(down.value(), 0);
+
+  // Backwards uses the same limits on |speed|.
+  MotionProfile back = makeProfile(0);
+  back.setTarget(-kFullScale);
+  CHECK_EQ(runToTarget(back), kAccelTicks);
+  back.setTarget(0);
+  CHECK_EQ(runToTarget(back), kDecelTicks);
+}
+
+void testMonotonicSegments() {
+  MotionProfile profile = makeProfile(0);
+  profile.setTarget(kFullScale);
+  runSegmentMonotonic(profile, kFullScale);
+  profile.setTarget(40);
+  runSegmentMonotonic(profile, 40);
+  profile.setTarget(-kFullScale);  // reversal: both halves
+  runSegmentMonotonic(profile, 0);
+  runSegmentMonotonic(profile, -kFullScale);
+  CHECK(profile.settled());
+}
+
+void testSCurveShape() {
+  // Jerk-limited: the first tick moves less than the middle ones.
+  MotionProfile profile = makeProfile(0);
+  profile.setTarget(kFullScale);
+  int32_t previous = 0;
+  int32_t firstStep = 0;
+  int32_t largestStep = 0;
+  for (int tick = 0; tick < kAccelTicks; ++tick) {
+    const int32_t value = profile.step();
+    const int32_t delta = value - previous;
+    if (tick == 0) {
+      firstStep = delta;
+    }
+    if (delta > largestStep) {
+      largestStep = delta;
+    }
+    previous = value;
+  }
+  CHECK(firstStep < largestStep);
+  CHECK(largestStep > kFullScale / kAccelTicks);  // peak above the average
+}
+
+void testReversalSplit() {
+  // -255 -> 100: a full-scale slow-down to 0 (20 ticks), then 0 -> 100 as a
+  // speed-up (ceil(100 * 50 / 255) = 20 ticks).
+  MotionProfile profile = makeProfile(-kFullScale);
+  profile.setTarget(100);
+  CHECK_EQ(profile.segmentTicks(), kDecelTicks);
+  CHECK_EQ(runSegmentMonotonic(profile, 0), 20);
+  CHECK(!profile.settled());
+  CHECK_EQ(profile.segmentTicks(), 20u);
+  CHECK_EQ(runSegmentMonotonic(profile, 100), 20);
+  CHECK(profile.settled());
+  CHECK_EQ(profile.value(), 100);
+}
+
+void testRestartMidSegment() {
+  MotionProfile profile = makeProfile(0);
+  profile.setTarget(kFullScale);
+  for (int tick = 0; tick < kAccelTicks / 2; ++tick) {
+    profile.step();
+  }
+  const int32_t midway = profile.value();
+  CHECK(midway > 0 && midway < kFullScale);
+
+  // Same target again: the segment carries on, nothing restarts.
+  profile.setTarget(kFullScale);
+  CHECK_EQ(profile.segmentTicks(), kAccelTicks);
+
+  // New target: a new slow-down segment from the current speed, sized by
+  // the remaining change.
+  profile.setTarget(0);
+  const uint32_t expected =
+      (static_cast<uint32_t>(midway) * kDecelTicks + kFullScale - 1) / kFullScale;
+  CHECK_EQ(profile.segmentTicks(), expected);
+  CHECK_EQ(profile.value(), midway);  // no jump at the restart
+  CHECK_EQ(runSegmentMonotonic(profile, 0), static_cast<int>(expected));
+  CHECK(profile.settled());
+}
+
+// Ticks until the value first reaches 90% of full scale; setpoints are
+// re-sent every kStreamTicks ticks, as from a streaming joystick.
+constexpr int kStreamTicks = 7;
+
+template <typename TargetAt>
+int ticksTo90(MotionProfile &profile, TargetAt targetAt) {
+  for (int tick = 0; tick < 1000; ++tick) {
+    if (tick % kStreamTicks == 0) {
+      profile.setTarget(targetAt(tick / kStreamTicks));
+    }
+    if (profile.step() >= kFullScale * 9 / 10) {
+      return tick + 1;
+    }
+  }
+  return -1;
+}
+
+void testStreamedRetarget() {
+  // A retarget in the direction of travel keeps the current rate: jittery
+  // setpoints near full speed ramp as fast as one steady target.
+  MotionProfile steady = makeProfile(0);
+  const int steadyTicks = ticksTo90(steady, [](int) { return kFullScale; });
+  MotionProfile jittery = makeProfile(0);
+  const int jitteryTicks =
+      ticksTo90(jittery, [](int update) { return update % 2 ? kFullScale - 5 : kFullScale; });
+  CHECK(steadyTicks > 0);
+  CHECK(jitteryTicks > 0 && jitteryTicks <= steadyTicks + 1);
+
+  // A stick pushed up gradually: no step backwards, none steeper than the
+  // peak of a full-scale speed-up, and it settles on the last setpoint.
+  MotionProfile reference = makeProfile(0);
+  reference.setTarget(kFullScale);
+  int32_t peakStep = 0;
+  for (int32_t previous = 0; !reference.settled();) {
+    const int32_t value = reference.step();
+    peakStep = value - previous > peakStep ? value - previous : peakStep;
+    previous = value;
+  }
+  MotionProfile rising = makeProfile(0);
+  int32_t previous = 0;
+  for (int tick = 0; tick < 200; ++tick) {
+    if (tick % kStreamTicks == 0) {
+      const int32_t target = 40 * (tick / kStreamTicks + 1);
+      rising.setTarget(target < kFullScale ? target : kFullScale);
+    }
+    const int32_t value = rising.step();
+    CHECK(value >= previous);
+    CHECK(value - previous <= peakStep);
+    previous = value;
+  }
+  CHECK(rising.settled());
+  CHECK_EQ(rising.value(), kFullScale);
+
+  // Mid-way through the slow-down half of a reversal, a new target on the
+  // far side keeps that half running instead of restarting it.
+  MotionProfile reversal = makeProfile(kFullScale);
+  reversal.setTarget(-kFullScale);
+  for (int tick = 0; tick < kDecelTicks / 2; ++tick) {
+    reversal.step();
+  }
+  reversal.setTarget(-100);
+  CHECK_EQ(reversal.segmentTicks(), kDecelTicks);
+  for (int tick = kDecelTicks / 2; tick < kDecelTicks; ++tick) {
+    const int32_t before = reversal.value();
+    CHECK(reversal.step() <= before);
+  }
+  CHECK_EQ(reversal.value(), 0);
+  CHECK_EQ(runSegmentMonotonic(reversal, -100), 20);  // ceil(100 * 50 / 255)
+  CHECK(reversal.settled());
+}
+
+}  // namespace
+
+int main() {
+  testFullScaleTicks();
+  testMonotonicSegments();
+  testSCurveShape();
+  testReversalSplit();
+  testRestartMidSegment();
+  testStreamedRetarget();
+  if (failures) {
+    std::printf("test_motion_profile: %d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("test_motion_profile: OK\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+"""Decode a gateway flight recorder dump into CSV.
+
+    curl -o flight.bin http://BRIDGE:8000/tanks/tank_001/flight
+    python flight_decode.py flight.bin > flight.csv
+
+Layouts follow FlightRecorder.h and BridgeProtocol.h (DumpHeader) in the
+gateway firmware; the file wrapper is written by server.py.
+"""
+import csv
+import json
+import struct
+import sys
+from datetime import datetime
+
+FLIGHT_MAGIC = b"FLT1"
+FILE_HEADER = struct.Struct("<QH")          # bridge wall clock ms, JSON meta length
+DUMP_HEADER = struct.Struct("<BBHIQ")       # type, flags, count, first index, gateway us at dump start
+RECORD = struct.Struct("<IBBBBHHI")         # time us (low 32), kind, tank, command, arg, aux, -, value
+MSG_DUMP = 0x04
+NO_TANK = 0xFF
+
+EVENTS = {1: "command", 2: "tx_done", 3: "tx_failed", 4: "preempted", 5: "status",
+          6: "link_up", 7: "link_down", 8: "link_dead", 9: "estop"}
+COMMANDS = {0: "stop", 1: "forward", 2: "backward", 3: "left", 4: "right", 5: "setspeed", 6: "channel"}
+COLUMNS = ["index", "time", "uptime_s", "event", "tank", "command", "radio_seq", "host_seq",
+           "left", "right", "gateway_us", "wifi_rssi", "free_heap", "link_ms", "lost"]
+
+
+def read_dump(data: bytes):
+    """Returns (wall clock ms, tank ids, gateway now us, [(index, record tuple)], [(index, lost)])."""
+    if data[:4] != FLIGHT_MAGIC:
+        raise ValueError("not a flight recorder dump")
+    wall_ms, meta_len = FILE_HEADER.unpack_from(data, 4)
+    offset = 4 + FILE_HEADER.size
+    tanks = json.loads(data[offset:offset + meta_len]).get("tanks", [])
+    offset += meta_len
+
+    now_us = 0
+    records, gaps = [], []
+    expected = None
+    while offset < len(data):
+        kind, flags, count, first, now_us = DUMP_HEADER.unpack_from(data, offset)
+        if kind != MSG_DUMP:
+            raise ValueError(f"unexpected message type {kind:#x} at byte {offset}")
+        offset += DUMP_HEADER.size
+        if expected is not None and first > expected:
+            gaps.append((first, first - expected))  # overwritten while dumping
+        for i in range(count):
+            records.append((first + i, RECORD.unpack_from(data, offset)))
+            offset += RECORD.size
+        expected = first + count
+    return wall_ms, tanks, now_us, records, gaps
+
+
+def unwrap_times(records, now_us: int):
+    """Extends the 32-bit timestamps to 64 bits, walking back from now_us."""
+    times = [0] * len(records)
+    later = now_us
+    for pos in range(len(records) - 1, -1, -1):
+        low = records[pos][1][0]
+        t = (later & ~0xFFFFFFFF) | low
+        if t > later:
+            t -= 1 << 32
+        times[pos] = t
+        later = t
+    return times
+
+
+def rows(data: bytes):
+    wall_ms, tanks, now_us, records, gaps = read_dump(data)
+    times = unwrap_times(records, now_us)
+    gap_at = dict(gaps)
+    for (index, rec), t_us in zip(records, times):
+        _, kind, tank, command, arg, aux, _, value = rec
+        if index in gap_at:
+            yield {"index": index, "event": "gap", "lost": gap_at.pop(index)}
+        wall = datetime.fromtimestamp((wall_ms - (now_us - t_us) / 1000.0) / 1000.0)
+        row = {"index": index, "time": wall.isoformat(timespec="milliseconds"),
+               "uptime_s": f"{t_us / 1e6:.6f}", "event": EVENTS.get(kind, f"kind{kind}"),
+               "tank": "" if tank == NO_TANK else (tanks[tank] if tank < len(tanks) else tank)}
+        if kind in (1, 2, 3, 4):
+            row.update(command=COMMANDS.get(command, command), radio_seq=arg, host_seq=aux)
+        if kind == 1:
+            row.update(left=value & 0xFF, right=(value >> 8) & 0xFF)
+        elif kind == 2:
+            row.update(gateway_us=value)
+        elif kind == 5:
+            row.update(wifi_rssi=struct.unpack("b", bytes([arg]))[0], free_heap=value)
+        elif kind in (6, 8):
+            row.update(link_ms=value)
+        yield row
+
+
+def main(argv):
+    if len(argv) != 2:
+        print(__doc__, file=sys.stderr)
+        return 2
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    writer = csv.DictWriter(sys.stdout, fieldnames=COLUMNS)
+    writer.writeheader()
+    for row in rows(data):
+        writer.writerow(row)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -1,11 +1,13 @@
 import asyncio
 import json
 import os
+import struct
+import time
 from pathlib import Path
 from typing import Dict, Optional, Set
 
 from fastapi import FastAPI, WebSocket, WebSocketDisconnect
-from fastapi.responses import HTMLResponse
+from fastapi.responses import HTMLResponse, JSONResponse, Response
 from fastapi.middleware.cors import CORSMiddleware
 
 app = FastAPI(title="WS Bridge: PC(web) -> Server(puente) -> LILYGO(ESP32)")
@@ -28,6 +30,12 @@ class TankConnection:
         self.tank_id = tank_id
         self.ws = ws
         self.lock = asyncio.Lock()
+        self.binary = False
+        self.next_seq = 0
+        self.tank_ids = [tank_id]
+        self.pending: Dict[int, tuple] = {}
+        self.dump: Optional[asyncio.Future] = None
+        self.dump_chunks: list = []
 
 TANKS: Dict[str, TankConnection] = {}
 
@@ -63,20 +71,179 @@ ACTION_MAP = {
     "left": "left",
     "right": "right",
     "stop": "stop",
+    "estop": "estop",
     "speed": "setspeed",
     "setspeed": "setspeed",
 }
 
+# Binary framing shared with the gateway (BridgeProtocol.h). Little-endian,
+# packed; the first byte is the message type.
+BIN_PROTO = "bin1"
+MSG_COMMAND, MSG_ACK, MSG_STATUS, MSG_DUMP = 0x01, 0x02, 0x03, 0x04
+COMMAND_STRUCT = struct.Struct("<BBBBBBH")    # type, tank, command, flags, left, right, seq
+ACK_STRUCT = struct.Struct("<BBBBBHBBI")      # type, tank, command, left, right, seq, radio seq, flags, gateway us
+STATUS_STRUCT = struct.Struct("<BBBBbBBBIII")  # type, state, left, right, rssi, channel, tank, -, uptime, heap, superseded
+HAS_LEFT, HAS_RIGHT, EMERGENCY_STOP = 0x01, 0x02, 0x04
+DUMP_HEADER = struct.Struct("<BBHIQ")         # type, flags, count, first index, gateway us at dump start
+DUMP_FIRST, DUMP_LAST = 0x01, 0x02
+COMMAND_CODES = {"stop": 0, "forward": 1, "backward": 2, "left": 3, "right": 4, "setspeed": 5}
+COMMAND_NAMES = {code: name for name, code in COMMAND_CODES.items()}
+
+def encode_command(cmd_obj: dict, tank_index: int = 0) -> bytes:
+    flags = 0
+    command = cmd_obj["command"]
+    if command == "estop":
+        flags |= EMERGENCY_STOP
+        command = "stop"
+    if "leftSpeed" in cmd_obj:
+        flags |= HAS_LEFT
+    if "rightSpeed" in cmd_obj:
+        flags |= HAS_RIGHT
+    return COMMAND_STRUCT.pack(MSG_COMMAND, tank_index, COMMAND_CODES[command], flags,
+                               cmd_obj.get("leftSpeed", 0) & 0xFF, cmd_obj.get("rightSpeed", 0) & 0xFF,
+                               cmd_obj["seq"])
+
+class LatencyHistogram:
+    """Fixed-bucket histogram in milliseconds; percentiles report the bucket bound."""
+    BOUNDS_MS = (1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, float("inf"))
+
+    def __init__(self):
+        self.counts = [0] * len(self.BOUNDS_MS)
+        self.total = 0
+        self.max_ms = 0.0
+
+    def record(self, ms: float):
+        for i, bound in enumerate(self.BOUNDS_MS):
+            if ms < bound:
+                self.counts[i] += 1
+                break
+        self.total += 1
+        self.max_ms = max(self.max_ms, ms)
+
+    def percentile(self, p: float) -> float:
+        if not self.total:
+            return 0.0
+        rank = self.total * p / 100.0
+        seen = 0
+        for bound, count in zip(self.BOUNDS_MS, self.counts):
+            seen += count
+            if seen >= rank:
+                return self.max_ms if bound == float("inf") else float(bound)
+        return self.max_ms
+
+    def summary(self) -> dict:
+        return {"p50": self.percentile(50), "p99": self.percentile(99),
+                "max": round(self.max_ms, 2), "n": self.total}
+
+HOP_LATENCY: Dict[str, LatencyHistogram] = {name: LatencyHistogram() for name in ("bridge", "gateway", "link")}
+PENDING_LIMIT = 64
+
+def annotate_tx_ack(conn: "TankConnection", ack: dict):
+    entry = conn.pending.pop(ack.get("seq"), None)
+    if entry is None:
+        return
+    client_ts, rx_at, tx_at = entry
+    bridge_ms = (tx_at - rx_at) * 1000.0
+    round_trip_ms = (time.monotonic() - tx_at) * 1000.0
+    gateway_ms = ack.get("gwUs", 0) / 1000.0
+    link_ms = max(0.0, round_trip_ms - gateway_ms)
+    HOP_LATENCY["bridge"].record(bridge_ms)
+    HOP_LATENCY["gateway"].record(gateway_ms)
+    HOP_LATENCY["link"].record(link_ms)
+    ack["hops"] = {"bridgeMs": round(bridge_ms, 2), "gatewayMs": round(gateway_ms, 2), "linkMs": round(link_ms, 2)}
+    if client_ts is not None:
+        ack["clientTs"] = client_ts
+
+def tank_for_index(conn: "TankConnection", index: int) -> str:
+    return conn.tank_ids[index] if index < len(conn.tank_ids) else conn.tank_id
+
+def tank_index(conn: "TankConnection", tank_id: str) -> int:
+    return conn.tank_ids.index(tank_id) if tank_id in conn.tank_ids else 0
+
+FLIGHT_MAGIC = b"FLT1"
+DUMP_TIMEOUT_S = 30
+
+def collect_dump_chunk(conn: "TankConnection", data: bytes):
+    if conn.dump is None or conn.dump.done() or len(data) < DUMP_HEADER.size:
+        return
+    flags = DUMP_HEADER.unpack_from(data)[1]
+    if flags & DUMP_FIRST:
+        conn.dump_chunks = []
+    conn.dump_chunks.append(data)
+    if flags & DUMP_LAST:
+        conn.dump.set_result(b"".join(conn.dump_chunks))
+        conn.dump_chunks = []
+
+def decode_tank_binary(conn: "TankConnection", data: bytes) -> Optional[dict]:
+    if not data:
+        return None
+    if data[0] == MSG_ACK and len(data) == ACK_STRUCT.size:
+        _, tank, cmd, left, right, seq, radio_seq, flags, gw_us = ACK_STRUCT.unpack(data)
+        return {"type": "tx_ack", "tankId": tank_for_index(conn, tank), "command": COMMAND_NAMES.get(cmd, "stop"),
+                "leftSpeed": left, "rightSpeed": right, "seq": seq, "radioSeq": radio_seq,
+                "transmitted": bool(flags & 0x01), "gwUs": gw_us}
+    if data[0] == MSG_STATUS and len(data) == STATUS_STRUCT.size:
+        _, state, left, right, rssi, channel, tank, _, uptime, heap, superseded = STATUS_STRUCT.unpack(data)
+        return {"type": "status", "tankId": tank_for_index(conn, tank), "state": COMMAND_NAMES.get(state, "stop"),
+                "leftSpeed": left, "rightSpeed": right, "wifiRssi": rssi, "uptime": uptime,
+                "freeHeap": heap, "radio": {"channel": channel}, "mailbox": {"superseded": superseded}}
+    return None
+
 @app.get("/")
 async def serve_index() -> HTMLResponse:
     if INDEX_HTML.exists():
         return HTMLResponse(INDEX_HTML.read_text(encoding="utf-8"))
     return HTMLResponse("<html><body><h3>WS Bridge</h3><p>Index not found.</p></body></html>")
 
+@app.get("/latency")
+async def latency():
+    return {name: hist.summary() for name, hist in HOP_LATENCY.items()}
+
 @app.get("/health")
 async def health():
     return {"status": "ok", "tanks": list(TANKS.keys())}
 
+@app.get("/tanks/{tank_id}/flight")
+async def flight_dump(tank_id: str):
+    conn = TANKS.get(tank_id)
+    if conn is None:
+        return JSONResponse({"error": "tank_offline", "tankId": tank_id}, status_code=404)
+    if conn.dump is not None and not conn.dump.done():
+        return JSONResponse({"error": "dump_in_progress", "tankId": tank_id}, status_code=409)
+    conn.dump = asyncio.get_running_loop().create_future()
+    wall_ms = int(time.time() * 1000)
+    async with conn.lock:
+        await conn.ws.send_text(json.dumps({"type": "dump"}))
+    try:
+        data = await asyncio.wait_for(conn.dump, DUMP_TIMEOUT_S)
+    except (asyncio.TimeoutError, ConnectionError):
+        return JSONResponse({"error": "dump_failed", "tankId": tank_id}, status_code=504)
+    meta = json.dumps({"tanks": conn.tank_ids}).encode()
+    body = FLIGHT_MAGIC + struct.pack("<QH", wall_ms, len(meta)) + meta + data
+    return Response(body, media_type="application/octet-stream",
+                    headers={"Content-Disposition": f'attachment; filename="flight-{tank_id}.bin"'})
+
+async def register_tanks(conn: TankConnection, tank_ids: list):
+    for tid in tank_ids:
+        prev = TANKS.get(tid)
+        if prev is conn:
+            continue
+        if prev is not None:
+            try:
+                await prev.ws.close()
+            except Exception:
+                pass
+        TANKS[tid] = conn
+        await broadcast_to_clients_for_tank(tid, {"type": "tank_online", "tankId": tid})
+    conn.tank_ids = tank_ids  # gateway order: binary messages carry the index
+
+async def forward_from_tank(conn: TankConnection, data: dict):
+    if data.get("tankId") not in conn.tank_ids:
+        data["tankId"] = conn.tank_id
+    if data["type"] == "tx_ack":
+        annotate_tx_ack(conn, data)
+    await broadcast_to_clients_for_tank(data["tankId"], data)
+
 @app.websocket("/ws/tank/{tank_id}")
 async def ws_tank_endpoint(websocket: WebSocket, tank_id: str):
     await websocket.accept()
@@ -91,16 +258,35 @@ async def ws_tank_endpoint(websocket: WebSocket, tank_id: str):
     await broadcast_to_clients_for_tank(tank_id, {"type": "tank_online", "tankId": tank_id})
     try:
         while True:
-            msg = await websocket.receive_text()
+            frame = await websocket.receive()
+            if frame["type"] == "websocket.disconnect":
+                break
+            if frame.get("bytes") is not None:
+                if frame["bytes"][:1] == bytes([MSG_DUMP]):
+                    collect_dump_chunk(conn, frame["bytes"])
+                    continue
+                decoded = decode_tank_binary(conn, frame["bytes"])
+                if decoded is not None:
+                    await forward_from_tank(conn, decoded)
+                continue
+            msg = frame.get("text") or ""
             try:
                 data = json.loads(msg)
             except json.JSONDecodeError:
                 await broadcast_to_clients_for_tank(tank_id, {"type": "status", "tankId": tank_id, "raw": msg})
                 continue
             if isinstance(data, dict):
-                if data.get("type") == "status":
-                    data["tankId"] = tank_id
-                    await broadcast_to_clients_for_tank(tank_id, data)
+                if data.get("type") == "hello":
+                    if data.get("proto") == BIN_PROTO:
+                        async with conn.lock:
+                            await websocket.send_text(json.dumps({"type": "proto", "proto": BIN_PROTO}))
+                        conn.binary = True
+                    tanks = data.get("tanks")
+                    if isinstance(tanks, list) and tanks:
+                        await register_tanks(conn, [str(t) for t in tanks])
+                    continue
+                if data.get("type") in ("status", "delta", "link", "radio", "latency", "tx_ack", "sensor"):
+                    await forward_from_tank(conn, data)
                 else:
                     await broadcast_to_clients_for_tank(tank_id, {"type": "status", "tankId": tank_id, "data": data})
             else:
@@ -110,10 +296,12 @@ async def ws_tank_endpoint(websocket: WebSocket, tank_id: str):
     except Exception:
         pass
     finally:
-        cur = TANKS.get(tank_id)
-        if cur is conn:
-            TANKS.pop(tank_id, None)
-        await broadcast_to_clients_for_tank(tank_id, {"type": "tank_offline", "tankId": tank_id})
+        if conn.dump is not None and not conn.dump.done():
+            conn.dump.set_exception(ConnectionError("gateway disconnected"))
+        for tid in dict.fromkeys([tank_id] + conn.tank_ids):
+            if TANKS.get(tid) is conn:
+                TANKS.pop(tid, None)
+            await broadcast_to_clients_for_tank(tid, {"type": "tank_offline", "tankId": tid})
         try:
             await websocket.close()
         except Exception:
@@ -129,6 +317,7 @@ async def ws_control_endpoint(websocket: WebSocket):
     try:
         while True:
             msg = await websocket.receive_text()
+            rx_at = time.monotonic()
             try:
                 payload = json.loads(msg)
             except json.JSONDecodeError:
@@ -153,7 +342,7 @@ async def ws_control_endpoint(websocket: WebSocket):
                 command = ACTION_MAP.get(action, "stop")
                 left = payload.get("leftSpeed")
                 right = payload.get("rightSpeed")
-                cmd_obj = {"command": command}
+                cmd_obj = {"command": command, "tankId": tank_id}
                 if command == "setspeed":
                     cmd_obj["leftSpeed"] = int(left) if left is not None else 0
                     cmd_obj["rightSpeed"] = int(right) if right is not None else 0
@@ -162,9 +351,18 @@ async def ws_control_endpoint(websocket: WebSocket):
                         cmd_obj["leftSpeed"] = int(left)
                     if right is not None:
                         cmd_obj["rightSpeed"] = int(right)
+                tank.next_seq = (tank.next_seq + 1) & 0xFFFF or 1
+                cmd_obj["seq"] = tank.next_seq
+
                 try:
                     async with tank.lock:
-                        await tank.ws.send_text(json.dumps(cmd_obj))
+                        if tank.binary:
+                            await tank.ws.send_bytes(encode_command(cmd_obj, tank_index(tank, tank_id)))
+                        else:
+                            await tank.ws.send_text(json.dumps(cmd_obj))
+                    tank.pending[cmd_obj["seq"]] = (payload.get("clientTs"), rx_at, time.monotonic())
+                    if len(tank.pending) > PENDING_LIMIT:
+                        tank.pending.pop(next(iter(tank.pending)))
                     await safe_send_json(websocket, {"type": "ack", "tankId": tank_id, "command": command})
                 except Exception as e:
                     await safe_send_json(websocket, {"type": "error", "error": "send_failed", "detail": str(e)})
@@ -185,4 +383,7 @@ async def ws_control_endpoint(websocket: WebSocket):
 if __name__ == "__main__":
     import uvicorn
     port = int(os.getenv("PORT", "8000"))
-    uvicorn.run(app, host="0.0.0.0", port=port)
+    tls = {}
+    if os.getenv("SSL_CERTFILE"):
+        tls = {"ssl_certfile": os.environ["SSL_CERTFILE"], "ssl_keyfile": os.getenv("SSL_KEYFILE")}
+    uvicorn.run(app, host="0.0.0.0", port=port, **tls)
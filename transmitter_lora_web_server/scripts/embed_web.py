@@ -0,0 +1,57 @@
+"""Compress web/index.html into src/IndexPage.h for the firmware.
+
+Runs as a PlatformIO pre-build script (extra_scripts in platformio.ini), so
+editing the page and building is enough. It can also be run by hand:
+
+    python scripts/embed_web.py
+
+The output is deterministic (gzip mtime 0), so the header only changes, and
+the ETag only moves, when the page does.
+"""
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "web", "index.html")
+TARGET = os.path.join(PROJECT_DIR, "src", "IndexPage.h")
+
+
+def render(html: bytes) -> str:
+    packed = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(html).hexdigest()[:16]
+    lines = [
+        "#pragma once",
+        "#include <Arduino.h>",
+        "",
+        "// Generated by scripts/embed_web.py from web/index.html; do not edit.",
+        f"// {len(html)} bytes of HTML, {len(packed)} bytes gzip-compressed.",
+        f'constexpr char kIndexPageEtag[] = "\\"{etag}\\"";',
+        f"constexpr size_t kIndexPageHtmlSize = {len(html)};",
+        f"constexpr size_t kIndexPageGzSize = {len(packed)};",
+        "const uint8_t kIndexPageGz[] PROGMEM = {",
+    ]
+    for i in range(0, len(packed), 16):
+        lines.append("  " + ", ".join(f"0x{b:02x}" for b in packed[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        header = render(f.read())
+    if os.path.exists(TARGET):
+        with open(TARGET) as f:
+            if f.read() == header:
+                return
+    with open(TARGET, "w") as f:
+        f.write(header)
+    print(f"embed_web: wrote {os.path.relpath(TARGET, PROJECT_DIR)}")
+
+
+main()
@@ -9,6 +9,104 @@ constexpr uint8_t kMagic[4] = {'T', 'A', 'N', 'K'};
 constexpr uint8_t kProtocolVersion = 1;
 constexpr size_t kFrameSize = 16;
 
+// ControlFrame::address of frames meant for every receiver (channel
+// announcements, single-tank setups). Receivers flashed with a non-zero
+// TANK_RADIO_ADDRESS also accept their own address.
+constexpr uint8_t kBroadcastAddress = 0;
+
+// Parked-mode wake-up. After kParkAfterIdleMs without frames the receiver
+// sleeps and only runs CAD every kCadPeriodMs, so the first frame after a
+// long idle carries a preamble that outlasts one CAD period (SF7/125 kHz:
+// 1.024 ms per symbol). Transmitters switch to it a little earlier than the
+// receiver parks to absorb clock skew.
+constexpr uint32_t kParkAfterIdleMs = 60000;
+constexpr uint32_t kWakeAfterIdleMs = 45000;
+constexpr uint32_t kCadPeriodMs = 200;
+constexpr long kDefaultPreambleSymbols = 8;
+constexpr long kWakePreambleSymbols = 256;
+
+// Link-loss watchdog. A receiver that is driving and hears no frame for
+// kLinkTimeoutMs ramps to a stop, so a dead link can't leave the tank
+// running on its last command. While a tank is moving, transmitters repeat
+// its current command (a heartbeat, fresh sequence) whenever nothing else
+// went on air for it within kHeartbeatIntervalMs; any real frame counts as
+// one. Both ends must be built with the same WATCHDOG_TIMEOUT_MS.
+#ifndef WATCHDOG_TIMEOUT_MS
+#define WATCHDOG_TIMEOUT_MS 2000
+#endif
+constexpr uint32_t kLinkTimeoutMs = WATCHDOG_TIMEOUT_MS;
+constexpr uint32_t kHeartbeatIntervalMs = kLinkTimeoutMs / 4;  // three may be lost
+
+// Channel plan for the control link. The gateway scans it at boot and
+// announces the quietest entry with a Command::Channel frame (channel index
+// in leftSpeed) on the rendezvous frequency, where the receiver waits
+// whenever it has no link. The gateway repeats the announcement before the
+// first frame after kAnnounceAfterIdleMs, a little before the receiver
+// gives up on the data channel at kRendezvousAfterIdleMs, and at least every
+// kAnnounceRepeatMs while frames keep flowing: a receiver that lost the
+// data channel (the gateway rebooted onto another one) hears nothing there,
+// falls back to the rendezvous frequency and is found again within that.
+constexpr float kRendezvousMHz = 920.0f;
+constexpr float kChannelPlanMHz[] = {920.0f, 920.6f, 921.2f, 921.8f, 922.4f};
+constexpr size_t kChannelCount = sizeof(kChannelPlanMHz) / sizeof(kChannelPlanMHz[0]);
+constexpr uint32_t kAnnounceAfterIdleMs = 10000;
+constexpr uint32_t kRendezvousAfterIdleMs = 15000;
+constexpr uint32_t kAnnounceRepeatMs = kRendezvousAfterIdleMs / 2;
+constexpr uint32_t kAnnounceGuardMs = 20;  // receiver retune before the next frame
+
+// Compact link profile: every control frame is exactly kFrameSize bytes, so
+// both ends can drop the LoRa header (implicit mode, fixed length) and use
+// the shortest preamble the SX127x accepts. Must match on TX and RX; enable
+// it here or with -DCONFIG_RADIO_COMPACT_LINK=1 on every build.
+#ifndef CONFIG_RADIO_COMPACT_LINK
+#define CONFIG_RADIO_COMPACT_LINK 0
+#endif
+
+#if CONFIG_RADIO_COMPACT_LINK
+constexpr bool kImplicitHeader = true;
+constexpr long kLinkPreambleSymbols = 6;
+#else
+constexpr bool kImplicitHeader = false;
+constexpr long kLinkPreambleSymbols = kDefaultPreambleSymbols;
+#endif
+
+// Semtech SX127x time-on-air (AN1200.13), in microseconds.
+inline uint32_t timeOnAirUs(uint8_t spreadingFactor, uint32_t bandwidthHz,
+                            uint8_t codingRateDenominator, long preambleSymbols,
+                            size_t payloadLength, bool implicitHeader,
+                            bool crc) {
+  const uint32_t symbolUs =
+      static_cast<uint32_t>((1000000ULL << spreadingFactor) / bandwidthHz);
+  const bool lowDataRate = symbolUs > 16000;
+  const int32_t numerator = 8 * static_cast<int32_t>(payloadLength) -
+                            4 * spreadingFactor + 28 + (crc ? 16 : 0) -
+                            (implicitHeader ? 20 : 0);
+  const int32_t denominator = 4 * (spreadingFactor - (lowDataRate ? 2 : 0));
+  int32_t blocks = numerator > 0 ? (numerator + denominator - 1) / denominator : 0;
+  const uint32_t payloadSymbols = 8 + blocks * codingRateDenominator;
+  // Preamble is (n + 4.25) symbols; keep it integral by working in quarters.
+  const uint32_t preambleUs =
+      static_cast<uint32_t>((4 * preambleSymbols + 17) * symbolUs / 4);
+  return preambleUs + payloadSymbols * symbolUs;
+}
+
+// Boot banner comparing the active profile against the explicit default.
+inline void printLinkProfile(Print &out, uint8_t spreadingFactor,
+                             uint32_t bandwidthHz,
+                             uint8_t codingRateDenominator) {
+  const uint32_t baseline =
+      timeOnAirUs(spreadingFactor, bandwidthHz, codingRateDenominator,
+                  kDefaultPreambleSymbols, kFrameSize, false, true);
+  const uint32_t active =
+      timeOnAirUs(spreadingFactor, bandwidthHz, codingRateDenominator,
+                  kLinkPreambleSymbols, kFrameSize, kImplicitHeader, true);
+  out.printf("[LoRa] Link profile: %s, %ld-symbol preamble, ToA %.2f ms "
+             "(explicit default %.2f ms, saving %.2f ms)\n",
+             kImplicitHeader ? "compact implicit-header" : "explicit-header",
+             kLinkPreambleSymbols, active / 1000.0f, baseline / 1000.0f,
+             (static_cast<int32_t>(baseline) - static_cast<int32_t>(active)) / 1000.0f);
+}
+
 // AES-256-CBC shared secrets (replace in production).
 const uint8_t kAesKey[32] = {
     0x51, 0x2A, 0xCE, 0x77, 0x48, 0x93, 0x11, 0xBA,
@@ -26,7 +124,8 @@ enum class Command : uint8_t {
   Backward = 2,
   Left = 3,
   Right = 4,
-  SetSpeed = 5
+  SetSpeed = 5,
+  Channel = 6
 };
 
 #pragma pack(push, 1)
@@ -36,8 +135,9 @@ struct ControlFrame {
   uint8_t command;
   uint8_t leftSpeed;
   uint8_t rightSpeed;
-  uint8_t sequence;
-  uint8_t reserved[3];
+  uint8_t sequence;     // per destination address
+  uint8_t address;      // kBroadcastAddress or a tank's TANK_RADIO_ADDRESS
+  uint8_t reserved[2];
   uint32_t crc32;
 };
 #pragma pack(pop)
@@ -56,13 +156,15 @@ inline uint32_t crc32(const uint8_t *data, size_t length) {
 
 inline void initFrame(ControlFrame &frame, Command command,
                       uint8_t leftSpeed, uint8_t rightSpeed,
-                      uint8_t sequence) {
+                      uint8_t sequence,
+                      uint8_t address = kBroadcastAddress) {
   memcpy(frame.magic, kMagic, sizeof(kMagic));
   frame.version = kProtocolVersion;
   frame.command = static_cast<uint8_t>(command);
   frame.leftSpeed = leftSpeed;
   frame.rightSpeed = rightSpeed;
   frame.sequence = sequence;
+  frame.address = address;
   memset(frame.reserved, 0, sizeof(frame.reserved));
   frame.crc32 = crc32(reinterpret_cast<const uint8_t *>(&frame), 12);
 }
@@ -141,8 +243,85 @@ inline Command commandFromFrame(const ControlFrame &frame) {
     case static_cast<uint8_t>(Command::Left): return Command::Left;
     case static_cast<uint8_t>(Command::Right): return Command::Right;
     case static_cast<uint8_t>(Command::SetSpeed): return Command::SetSpeed;
+    case static_cast<uint8_t>(Command::Channel): return Command::Channel;
     default: return Command::Stop;
   }
 }
 
+// Commands that leave the motors turning (the ones the watchdog guards).
+inline bool isMotion(Command command) {
+  return command == Command::Forward || command == Command::Backward ||
+         command == Command::Left || command == Command::Right;
+}
+
+// Command tokens accepted on the JSON control path, resolved without
+// building a String: the hash below is perfect for this set (checked at
+// compile time), so a lookup is one hash, one slot and one in-place
+// case-insensitive compare. Keep the C++11 single-return constexpr form.
+struct CommandToken {
+  const char *name;
+  uint8_t length;
+  Command command;
+};
+
+constexpr char asciiLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr size_t kCommandSlots = 8;
+
+constexpr size_t commandHash(const char *token, size_t length) {
+  return length < 2 ? 0
+                    : (static_cast<size_t>(asciiLower(token[0])) +
+                       2 * static_cast<size_t>(asciiLower(token[1])) + length) &
+                          (kCommandSlots - 1);
+}
+
+constexpr CommandToken kCommandTokens[kCommandSlots] = {
+    {nullptr, 0, Command::Stop},
+    {"right", 5, Command::Right},
+    {"left", 4, Command::Left},
+    {"forward", 7, Command::Forward},
+    {"backward", 8, Command::Backward},
+    {"setspeed", 8, Command::SetSpeed},
+    {nullptr, 0, Command::Stop},
+    {"stop", 4, Command::Stop}};
+
+constexpr bool commandSlotIsPerfect(size_t slot) {
+  return slot >= kCommandSlots ||
+         ((kCommandTokens[slot].name == nullptr ||
+           commandHash(kCommandTokens[slot].name, kCommandTokens[slot].length) == slot) &&
+          commandSlotIsPerfect(slot + 1));
+}
+static_assert(commandSlotIsPerfect(0), "kCommandTokens no longer matches commandHash");
+
+constexpr bool tokenEquals(const char *token, const char *name, size_t length) {
+  return length == 0 ||
+         (asciiLower(*token) == *name && tokenEquals(token + 1, name + 1, length - 1));
+}
+
+// Slot of a case-insensitive command token (not NUL terminated), or
+// kCommandSlots when it is not a command.
+constexpr size_t commandSlot(const char *token, size_t length, size_t slot) {
+  return (kCommandTokens[slot].name != nullptr && kCommandTokens[slot].length == length &&
+          tokenEquals(token, kCommandTokens[slot].name, length))
+             ? slot
+             : kCommandSlots;
+}
+constexpr size_t commandSlot(const char *token, size_t length) {
+  return token == nullptr ? kCommandSlots : commandSlot(token, length, commandHash(token, length));
+}
+static_assert(commandSlot("SetSpeed", 8) == 5 && commandSlot("stop", 4) == 7 &&
+                  commandSlot("spin", 4) == kCommandSlots,
+              "commandSlot lookup broken");
+
+inline bool commandFromToken(const char *token, size_t length, Command &out) {
+  const size_t slot = commandSlot(token, length);
+  if (slot == kCommandSlots) {
+    return false;
+  }
+  out = kCommandTokens[slot].command;
+  return true;
+}
+
 }  // namespace TankControl
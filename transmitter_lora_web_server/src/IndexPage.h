@@ -0,0 +1,214 @@
+#pragma once
+#include <Arduino.h>
+
+// Generated by scripts/embed_web.py from web/index.html; do not edit.
+// 8841 bytes of HTML, 3249 bytes gzip-compressed.
+constexpr char kIndexPageEtag[] = "\"285919aba5955eff\"";
+constexpr size_t kIndexPageHtmlSize = 8841;
+constexpr size_t kIndexPageGzSize = 3249;
+const uint8_t kIndexPageGz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0x7b, 0x6f, 0x1b, 0x37,
+  0x12, 0xff, 0xbf, 0x9f, 0x62, 0xaa, 0xba, 0xd0, 0xaa, 0x95, 0x56, 0xb2, 0x1d, 0xf7, 0x7c, 0xb6,
+  0xa4, 0x22, 0x4e, 0x1d, 0x34, 0x85, 0xd3, 0x18, 0x96, 0xfb, 0x38, 0x04, 0x01, 0x4c, 0xed, 0x52,
+  0x12, 0xeb, 0xd5, 0x72, 0x43, 0x52, 0x96, 0x55, 0x57, 0xdf, 0xfd, 0x66, 0x48, 0xee, 0x53, 0x7e,
+  0xb4, 0x87, 0x03, 0x02, 0x7b, 0x77, 0x39, 0x33, 0x9c, 0xc7, 0x6f, 0x1e, 0xa4, 0x33, 0xfc, 0xf2,
+  0x87, 0x0f, 0x6f, 0xae, 0xff, 0x73, 0x79, 0x0e, 0x0b, 0xb3, 0x4c, 0xc6, 0x5f, 0x0c, 0xf3, 0x5f,
+  0x9c, 0xc5, 0xe3, 0x2f, 0x00, 0x86, 0x4b, 0x6e, 0x18, 0x44, 0x0b, 0xa6, 0x34, 0x37, 0xa3, 0xd6,
+  0xca, 0xcc, 0x7a, 0xc7, 0xad, 0x72, 0x21, 0x65, 0x4b, 0x3e, 0x6a, 0xdd, 0x09, 0xbe, 0xce, 0xa4,
+  0x32, 0x2d, 0x88, 0x64, 0x6a, 0x78, 0x8a, 0x84, 0x6b, 0x11, 0x9b, 0xc5, 0x28, 0xe6, 0x77, 0x22,
+  0xe2, 0x3d, 0xfb, 0xd2, 0x15, 0xa9, 0x30, 0x82, 0x25, 0x3d, 0x1d, 0xb1, 0x84, 0x8f, 0xf6, 0x9d,
+  0x14, 0x23, 0x4c, 0xc2, 0xc7, 0xd7, 0x2c, 0xbd, 0x85, 0x37, 0xc8, 0xab, 0x64, 0x92, 0x70, 0x05,
+  0xd7, 0xbf, 0x0f, 0xfb, 0x6e, 0x85, 0x68, 0xb4, 0xd9, 0xb8, 0x27, 0x80, 0xa9, 0x8c, 0x37, 0xf0,
+  0x00, 0x33, 0x24, 0xed, 0xcd, 0xd8, 0x52, 0x24, 0x9b, 0x13, 0xd0, 0x2c, 0xd5, 0x3d, 0xcd, 0x95,
+  0x98, 0x9d, 0xc2, 0x92, 0xa9, 0xb9, 0x48, 0x4f, 0x60, 0x70, 0x0a, 0x19, 0x8b, 0x63, 0x91, 0xce,
+  0x4f, 0xe0, 0x40, 0xf1, 0xe5, 0x29, 0x4c, 0x59, 0x74, 0x3b, 0x57, 0x72, 0x95, 0xc6, 0x27, 0xf0,
+  0xd5, 0xfe, 0x60, 0xff, 0xf8, 0x00, 0x69, 0x22, 0x99, 0x48, 0x85, 0xef, 0x9c, 0xf3, 0x53, 0xd8,
+  0xda, 0x1d, 0x16, 0xfb, 0x28, 0xdf, 0x89, 0xe9, 0x19, 0x99, 0x59, 0x51, 0x6e, 0x65, 0xba, 0x32,
+  0x46, 0xa6, 0xb8, 0x6a, 0xcd, 0x39, 0x81, 0x63, 0x2b, 0x77, 0xc1, 0xc5, 0x7c, 0x61, 0x4e, 0xe0,
+  0xd0, 0xbe, 0x15, 0xfb, 0x87, 0x47, 0xf6, 0xdd, 0x2a, 0xaa, 0xc5, 0x9f, 0xfc, 0x04, 0xf6, 0x9d,
+  0x1a, 0x52, 0xc5, 0x1c, 0xb7, 0x4c, 0x65, 0xca, 0xf3, 0xb7, 0x9e, 0x62, 0xb1, 0x58, 0xe9, 0x92,
+  0x2b, 0x5a, 0x29, 0x4d, 0x7a, 0x65, 0x52, 0xa0, 0x3b, 0x55, 0x43, 0xf9, 0xd9, 0xec, 0x5f, 0x6c,
+  0xff, 0xb8, 0x54, 0x3e, 0x37, 0xa6, 0xaa, 0x65, 0xa8, 0x51, 0x77, 0x54, 0xb5, 0xc1, 0x78, 0x38,
+  0x3d, 0xac, 0x58, 0x3d, 0x9b, 0xcd, 0x72, 0xae, 0xaf, 0xb4, 0x61, 0x66, 0xa5, 0x1b, 0xa6, 0xef,
+  0x3f, 0x62, 0x45, 0xe8, 0xec, 0xf0, 0x6c, 0x86, 0x27, 0x1c, 0x81, 0xa0, 0x36, 0x4d, 0xa7, 0xed,
+  0x72, 0x0e, 0xc2, 0x7f, 0x3b, 0xe3, 0xfc, 0xee, 0x8c, 0xb1, 0x5c, 0x4c, 0x88, 0xb1, 0x42, 0x01,
+  0xb1, 0xd0, 0x59, 0xc2, 0x30, 0xa2, 0x73, 0x25, 0xe2, 0x53, 0xfb, 0xb3, 0x67, 0xf8, 0x12, 0xbf,
+  0x19, 0xde, 0x43, 0xb6, 0xd5, 0x32, 0x45, 0x27, 0x29, 0x9e, 0x71, 0x66, 0x82, 0xc3, 0x2e, 0x1c,
+  0xdb, 0x4d, 0x3a, 0x4d, 0x4a, 0x25, 0xd7, 0x35, 0xb2, 0xc3, 0x82, 0x8c, 0x55, 0x34, 0xfb, 0x63,
+  0xa5, 0x8d, 0x98, 0x6d, 0x7a, 0x1e, 0xb1, 0x27, 0x10, 0x71, 0xe7, 0xeb, 0xaa, 0x19, 0x07, 0x15,
+  0x5b, 0xad, 0x92, 0x4d, 0x0c, 0xec, 0x0f, 0x06, 0x5f, 0x97, 0x18, 0x70, 0x6f, 0x9e, 0x5c, 0x67,
+  0x9c, 0xc7, 0x4d, 0x8f, 0x3a, 0x81, 0x85, 0xa1, 0xb3, 0x84, 0xdf, 0x7b, 0xbd, 0xf6, 0x5f, 0xd2,
+  0xab, 0x2e, 0x36, 0x61, 0x53, 0x9e, 0x54, 0x7d, 0xe6, 0x44, 0xd1, 0xcf, 0x5e, 0x2c, 0x14, 0x8f,
+  0x8c, 0x90, 0x88, 0x43, 0xe7, 0xb5, 0x53, 0x60, 0x89, 0x98, 0xa7, 0x3d, 0x81, 0x3e, 0xd2, 0xa5,
+  0xc4, 0x47, 0x82, 0xe3, 0x36, 0x11, 0x69, 0xb6, 0x32, 0x1f, 0xcd, 0x26, 0xe3, 0x23, 0xc5, 0xd2,
+  0x39, 0xff, 0x54, 0x1a, 0x7c, 0x30, 0x18, 0x64, 0xf7, 0xa5, 0x32, 0x46, 0x44, 0xb7, 0xb8, 0x98,
+  0x49, 0x2d, 0xdc, 0x86, 0x8a, 0x63, 0x0c, 0xc4, 0x1d, 0x62, 0x3b, 0xf7, 0xd0, 0x41, 0x2d, 0x4d,
+  0xfc, 0x6b, 0x9e, 0x27, 0xf4, 0x06, 0x6c, 0x65, 0x24, 0xa5, 0x59, 0x23, 0x1b, 0x8e, 0xc8, 0x99,
+  0xf5, 0xb4, 0x8d, 0x0f, 0xd8, 0xe1, 0x77, 0xa7, 0x60, 0xe4, 0x2a, 0x5a, 0xf4, 0x98, 0xb7, 0xd1,
+  0xa5, 0x92, 0xd7, 0xe8, 0x36, 0x95, 0xd3, 0x9a, 0x42, 0x6c, 0xaa, 0xd1, 0x07, 0x06, 0x29, 0x12,
+  0x3e, 0x43, 0x05, 0x5e, 0xd9, 0xfd, 0x6d, 0x30, 0xdc, 0xa3, 0xd7, 0xf3, 0x55, 0x4d, 0xcd, 0x57,
+  0x95, 0x64, 0x7d, 0x46, 0xa1, 0x3c, 0x15, 0x7d, 0xa2, 0xf6, 0xf8, 0x1d, 0xba, 0x56, 0xd7, 0x55,
+  0x9a, 0x49, 0x89, 0x4b, 0x0d, 0x1c, 0x1c, 0xee, 0x66, 0xc7, 0xf1, 0xd1, 0x6e, 0x7a, 0x18, 0x7e,
+  0x6f, 0x7a, 0x36, 0x76, 0x75, 0x1c, 0x0c, 0xfb, 0xbe, 0x26, 0x0e, 0xfb, 0xae, 0x50, 0x0f, 0xa9,
+  0x30, 0xda, 0x62, 0xb9, 0xd8, 0x1f, 0x5f, 0xf7, 0xce, 0x38, 0x5b, 0x42, 0xa3, 0xa8, 0x22, 0xe9,
+  0xbe, 0xa5, 0xc8, 0xb0, 0xdc, 0x66, 0xc0, 0x72, 0x2c, 0x4b, 0x05, 0xb1, 0x62, 0x73, 0x30, 0x0b,
+  0x0e, 0x7f, 0xc8, 0x8d, 0x0b, 0x29, 0x06, 0x44, 0xf3, 0x34, 0x46, 0x6d, 0x96, 0x4b, 0x96, 0x22,
+  0xde, 0xe4, 0x1d, 0xda, 0x70, 0x21, 0xaf, 0x58, 0x88, 0x22, 0xfd, 0x37, 0xa6, 0x38, 0xbc, 0x3e,
+  0x9f, 0xf4, 0x0e, 0x8e, 0xbe, 0x03, 0x9e, 0x46, 0x6a, 0x93, 0x19, 0x1e, 0x87, 0xc3, 0x7e, 0x66,
+  0xb7, 0x89, 0xc5, 0x1d, 0x44, 0x09, 0xd3, 0x7a, 0xd4, 0xc2, 0xcc, 0x69, 0xb9, 0xfa, 0x4d, 0x5f,
+  0xc7, 0xc3, 0x3e, 0xfd, 0x74, 0xef, 0x5e, 0x89, 0x98, 0x19, 0xd6, 0x8b, 0x96, 0xf1, 0xa8, 0x35,
+  0x93, 0x6a, 0xcd, 0x14, 0xd2, 0xbf, 0x75, 0x0f, 0xc3, 0xbe, 0x23, 0xf9, 0xbb, 0xfc, 0x14, 0xe5,
+  0xd6, 0xf8, 0x02, 0x7f, 0x36, 0x38, 0x3d, 0xa5, 0x57, 0x89, 0xea, 0x63, 0xab, 0xc2, 0x66, 0xdf,
+  0xc7, 0x13, 0xfc, 0xf9, 0x38, 0x5b, 0x49, 0xa9, 0x08, 0x21, 0xad, 0xf1, 0x15, 0xfd, 0xfa, 0xa7,
+  0xca, 0x11, 0x78, 0x9c, 0x75, 0x67, 0xfe, 0xe9, 0x39, 0x09, 0xe5, 0x43, 0xc5, 0x97, 0x36, 0x3e,
+  0x2d, 0x10, 0x71, 0xfe, 0x38, 0xae, 0xae, 0x12, 0xfc, 0xdd, 0xa2, 0x7d, 0xf2, 0xb2, 0x1e, 0x17,
+  0x64, 0x0b, 0x49, 0x1e, 0x17, 0x5b, 0x4f, 0xac, 0xdb, 0xc0, 0x2e, 0xd8, 0xaf, 0xf8, 0xdd, 0x96,
+  0x02, 0x2b, 0x90, 0x1c, 0x3b, 0xa1, 0xa5, 0x16, 0xd8, 0xca, 0xd0, 0xb2, 0xa5, 0xa1, 0x05, 0x4b,
+  0x91, 0x8e, 0x5a, 0x03, 0xfc, 0xcd, 0xee, 0x47, 0xad, 0x83, 0xa3, 0xa3, 0x16, 0xdc, 0xb1, 0x64,
+  0xc5, 0xdd, 0xf3, 0x38, 0x97, 0xa3, 0x33, 0x96, 0x16, 0x62, 0x7e, 0x25, 0x82, 0xd6, 0x18, 0x09,
+  0x10, 0xc8, 0xb8, 0xe0, 0x75, 0xe8, 0x3b, 0x25, 0xaa, 0x0a, 0x59, 0x2f, 0x3f, 0xa5, 0x91, 0x8d,
+  0xc4, 0xff, 0x41, 0x25, 0x2b, 0xe7, 0xef, 0xe8, 0xb4, 0x13, 0x4f, 0xed, 0x36, 0x17, 0xf9, 0xe3,
+  0x99, 0x49, 0x11, 0x44, 0xdc, 0x80, 0xd5, 0x4a, 0x57, 0x83, 0x5b, 0x8f, 0x81, 0x0b, 0x1f, 0xb5,
+  0x5c, 0x02, 0x1d, 0x76, 0xad, 0x13, 0x78, 0xf7, 0xc3, 0xc5, 0xf9, 0x2e, 0x51, 0xd1, 0x60, 0x11,
+  0xd3, 0x22, 0xbd, 0x3d, 0x81, 0x35, 0xc3, 0xc2, 0x96, 0xce, 0xb1, 0x76, 0x28, 0x70, 0x12, 0xc2,
+  0x30, 0x2c, 0xf9, 0x5c, 0xb5, 0x19, 0x63, 0xda, 0xa7, 0xd8, 0x03, 0x28, 0x8f, 0x29, 0xaf, 0xa9,
+  0x14, 0x54, 0xc6, 0xab, 0xdf, 0x44, 0xef, 0xad, 0x80, 0x94, 0x9b, 0xb5, 0x54, 0xb7, 0x10, 0x64,
+  0x88, 0x07, 0x7c, 0xc2, 0x82, 0x66, 0x90, 0x6e, 0xff, 0xe0, 0xf0, 0xd5, 0x51, 0x27, 0x1c, 0x4e,
+  0xd5, 0xb8, 0x74, 0x51, 0xc6, 0xe6, 0xfc, 0x42, 0x52, 0x1a, 0x7b, 0xef, 0x0c, 0xfb, 0x7e, 0x27,
+  0x3b, 0xa0, 0x45, 0x4a, 0x64, 0xc6, 0x39, 0x09, 0xfb, 0x96, 0x36, 0x5e, 0xb3, 0xf3, 0x04, 0x46,
+  0x10, 0xcb, 0x68, 0xb5, 0xc4, 0xda, 0x15, 0xce, 0xb9, 0x39, 0x27, 0x63, 0x52, 0x73, 0xb6, 0x79,
+  0x17, 0x07, 0x6d, 0x47, 0xd3, 0xee, 0x9c, 0x56, 0xf8, 0x08, 0x1d, 0xcf, 0xf1, 0x14, 0x20, 0xac,
+  0xb3, 0xd9, 0x08, 0x3e, 0xc7, 0x57, 0x42, 0x65, 0x77, 0x3f, 0x1b, 0xf9, 0x97, 0x36, 0xb5, 0x44,
+  0x8f, 0x6c, 0xfa, 0x22, 0x73, 0x49, 0x45, 0xdc, 0xae, 0x23, 0xac, 0x52, 0xdb, 0xba, 0x60, 0x95,
+  0x21, 0x94, 0xf8, 0x05, 0x21, 0x4c, 0x07, 0x1d, 0x78, 0xf0, 0xc8, 0x2c, 0xf6, 0x0b, 0xa9, 0xfe,
+  0xbf, 0x71, 0x83, 0x00, 0xee, 0x41, 0xdf, 0x43, 0x8b, 0xe4, 0x53, 0x4f, 0x59, 0x0a, 0x6f, 0x90,
+  0xda, 0x85, 0x2a, 0xad, 0xeb, 0x45, 0x56, 0x02, 0xce, 0xc5, 0xe7, 0xd4, 0xa7, 0x2e, 0x84, 0x46,
+  0x6a, 0xae, 0x82, 0xb6, 0x4d, 0xa9, 0x76, 0xb7, 0xa6, 0x8f, 0x37, 0xd5, 0x09, 0xfa, 0x47, 0x2c,
+  0x75, 0xab, 0xbc, 0xcd, 0x4c, 0x6f, 0xd2, 0xa8, 0xb4, 0x9c, 0x9a, 0x8b, 0xef, 0x23, 0x01, 0x66,
+  0x52, 0x69, 0x7b, 0x0e, 0x9c, 0x86, 0x3d, 0x6d, 0x9f, 0x24, 0xc4, 0x87, 0xe8, 0x47, 0xc8, 0xb7,
+  0x73, 0x1f, 0xb8, 0x60, 0x64, 0x4c, 0xb1, 0xa5, 0x46, 0xca, 0x94, 0xaf, 0xe1, 0x97, 0xab, 0x8b,
+  0x09, 0x67, 0x2a, 0x5a, 0x5c, 0xda, 0xaf, 0xc1, 0x03, 0xe4, 0xb3, 0x02, 0xee, 0x05, 0xdb, 0x4e,
+  0xce, 0x2a, 0x66, 0x40, 0xbb, 0xc3, 0x68, 0x84, 0x3b, 0x68, 0x87, 0x8e, 0x42, 0x13, 0xf0, 0x32,
+  0x43, 0x3c, 0xf8, 0x38, 0x0c, 0xa0, 0xb9, 0x65, 0x08, 0x0a, 0x21, 0x75, 0x3a, 0xeb, 0x2f, 0x24,
+  0xac, 0x04, 0xa0, 0xa0, 0xdc, 0xfa, 0xdf, 0x76, 0x5c, 0x2e, 0xb8, 0x3d, 0x98, 0x38, 0x29, 0xcf,
+  0x28, 0xbb, 0x61, 0xc6, 0x4d, 0xb4, 0x08, 0xda, 0x7d, 0x54, 0x0d, 0x25, 0xe1, 0xe0, 0xc0, 0xcd,
+  0x42, 0x62, 0x76, 0xb6, 0x2f, 0x3f, 0x4c, 0xae, 0xf1, 0x0b, 0xf5, 0xfa, 0x93, 0xdc, 0xe2, 0x6d,
+  0x45, 0x11, 0xb2, 0xe7, 0x4b, 0x94, 0x14, 0xca, 0xdb, 0x0e, 0xe6, 0x3d, 0x0e, 0xc2, 0xd6, 0x1d,
+  0xe7, 0x4a, 0x49, 0x0c, 0xd9, 0x8f, 0xd7, 0xd7, 0x97, 0xd0, 0x86, 0x6f, 0x69, 0xaf, 0xd0, 0xf9,
+  0xb9, 0xc2, 0xeb, 0xd4, 0xa0, 0xd2, 0x56, 0xe8, 0x41, 0x74, 0x7f, 0x68, 0x99, 0x06, 0x15, 0xb2,
+  0x27, 0xe2, 0x73, 0xe3, 0xe3, 0xb3, 0xf7, 0x40, 0x12, 0xac, 0x74, 0xbe, 0xbd, 0x29, 0x0c, 0x87,
+  0x88, 0xa1, 0x49, 0x10, 0x70, 0xa5, 0xaa, 0x0e, 0x7e, 0x21, 0xd8, 0xe7, 0x57, 0x57, 0x1f, 0xae,
+  0xa0, 0x67, 0x75, 0x46, 0xce, 0x70, 0xc9, 0xb5, 0xc6, 0x3a, 0x54, 0x77, 0xe7, 0xd6, 0xe1, 0xab,
+  0xc8, 0xbf, 0xcf, 0x2b, 0xae, 0x36, 0x13, 0xac, 0x9a, 0x91, 0x91, 0xea, 0x75, 0x92, 0x04, 0x6d,
+  0x57, 0x83, 0x3f, 0xe6, 0x55, 0xfb, 0x53, 0xbb, 0x13, 0x62, 0xf1, 0x3c, 0x67, 0xe8, 0xe3, 0xa9,
+  0x49, 0x61, 0x34, 0x2e, 0x34, 0xc2, 0xd7, 0x47, 0xa0, 0x1e, 0x25, 0xd8, 0x66, 0xd1, 0xed, 0x98,
+  0xa1, 0x48, 0x5b, 0x45, 0x2e, 0xd1, 0x93, 0x58, 0x8c, 0x7c, 0x48, 0x28, 0xf6, 0x7e, 0xca, 0x43,
+  0xf2, 0x74, 0xe5, 0xf3, 0xbd, 0x02, 0x35, 0xf9, 0x27, 0xdb, 0xe5, 0x10, 0xcd, 0x73, 0xaa, 0xdf,
+  0x87, 0x9f, 0xf2, 0x81, 0xcd, 0xce, 0x67, 0x0c, 0x7e, 0xe3, 0xd3, 0x89, 0x8c, 0x6e, 0x39, 0x8e,
+  0xb0, 0x54, 0xf7, 0xdd, 0x5a, 0x3e, 0x0c, 0xc3, 0x5c, 0x22, 0xca, 0x24, 0x76, 0x4f, 0xa6, 0x01,
+  0x6b, 0x3f, 0x68, 0x1c, 0x2c, 0x7d, 0x63, 0x45, 0x59, 0xd3, 0x8d, 0xc1, 0xe5, 0xe0, 0xde, 0x61,
+  0xb7, 0x0b, 0x1b, 0xf0, 0xb3, 0x58, 0x17, 0x7a, 0x78, 0xb2, 0x09, 0x43, 0xfc, 0xd1, 0x01, 0x66,
+  0x60, 0x29, 0x11, 0x29, 0x38, 0xea, 0x22, 0x8c, 0x5f, 0x0d, 0x00, 0x31, 0xb8, 0x5e, 0x88, 0x84,
+  0x83, 0x30, 0xb9, 0xa4, 0x25, 0x6a, 0xa3, 0xbb, 0x80, 0x3a, 0x5b, 0x2d, 0x0c, 0xb6, 0x65, 0xbd,
+  0x14, 0x86, 0xc6, 0xe0, 0x5b, 0xce, 0x33, 0xd4, 0x21, 0x4d, 0x36, 0x76, 0x09, 0xe1, 0xc9, 0xb5,
+  0x09, 0xe1, 0x0a, 0x03, 0xc6, 0x34, 0xf5, 0x35, 0xc4, 0x1d, 0xd9, 0xac, 0x73, 0x59, 0x83, 0xee,
+  0x80, 0xf6, 0x94, 0x69, 0xc4, 0xbb, 0xb4, 0x11, 0xc2, 0xa8, 0x29, 0xd3, 0xac, 0x54, 0xaa, 0xf1,
+  0xd0, 0x82, 0xcd, 0x8e, 0x01, 0x8d, 0x70, 0x21, 0x9c, 0x5b, 0xed, 0x66, 0x98, 0x21, 0x48, 0xba,
+  0x60, 0x85, 0x66, 0xce, 0x03, 0x29, 0x30, 0xa1, 0x20, 0x70, 0xc0, 0x20, 0xce, 0x28, 0x59, 0xc5,
+  0x1c, 0xab, 0x90, 0xd0, 0x74, 0x6e, 0x94, 0x0a, 0xe7, 0x58, 0x3b, 0xe8, 0x13, 0xa9, 0xf5, 0x23,
+  0xc9, 0xd1, 0xd6, 0xb1, 0x61, 0xad, 0xcb, 0x91, 0x7b, 0x9f, 0x6d, 0x71, 0x14, 0xcb, 0x5a, 0xd7,
+  0xb0, 0x07, 0x94, 0x67, 0x58, 0x68, 0x3d, 0xe7, 0x48, 0x70, 0x92, 0x70, 0xbb, 0x52, 0x61, 0x5b,
+  0x25, 0x49, 0xf9, 0x39, 0x73, 0x85, 0x70, 0xe2, 0x35, 0xa8, 0x2f, 0xe2, 0x80, 0x67, 0xec, 0xca,
+  0x6b, 0x62, 0x1c, 0x54, 0x84, 0xd1, 0xc7, 0x6b, 0xb1, 0x44, 0xa7, 0x35, 0x79, 0x22, 0x37, 0x1e,
+  0xe8, 0x0b, 0x3c, 0xbc, 0xbd, 0x2e, 0xf6, 0xb3, 0x4e, 0x9b, 0x09, 0x85, 0x8a, 0x1b, 0x61, 0x7d,
+  0x59, 0x39, 0x24, 0x78, 0xd5, 0x24, 0xea, 0x82, 0x28, 0xaa, 0xb7, 0xb6, 0xc8, 0x0d, 0x20, 0x0e,
+  0x8c, 0x95, 0xde, 0x56, 0x9a, 0x83, 0x85, 0xa9, 0x40, 0x6b, 0x70, 0x83, 0x47, 0xf6, 0x7e, 0x7f,
+  0xef, 0x21, 0x91, 0x58, 0x29, 0x90, 0x3f, 0x5c, 0x20, 0xc6, 0xb6, 0xfd, 0xb5, 0xbe, 0x29, 0x6a,
+  0x8f, 0x77, 0xff, 0x54, 0xa4, 0x4c, 0x6d, 0xae, 0x71, 0xdc, 0xa3, 0x4a, 0xc1, 0x94, 0x62, 0x9b,
+  0xe9, 0x6a, 0x36, 0xe3, 0xaa, 0xdd, 0x20, 0x94, 0x29, 0x29, 0x86, 0x44, 0x2e, 0x91, 0x1e, 0x6a,
+  0x55, 0xb2, 0x69, 0xed, 0xc8, 0xd9, 0x5b, 0x2d, 0x4e, 0xb0, 0xeb, 0x92, 0x8c, 0x2b, 0x4c, 0x09,
+  0xcc, 0xc5, 0x88, 0x87, 0xa9, 0x5c, 0x57, 0xeb, 0x22, 0x78, 0xe0, 0x5c, 0xfa, 0x41, 0xa9, 0xba,
+  0x96, 0xd7, 0xfd, 0xed, 0x8e, 0x86, 0xbe, 0xa2, 0xa1, 0x68, 0x7e, 0x57, 0x57, 0xb2, 0x56, 0x8e,
+  0x7f, 0x9a, 0x7c, 0xf8, 0x39, 0xcc, 0xe8, 0x0a, 0x2e, 0xe0, 0x77, 0xb6, 0xe2, 0xbc, 0x5c, 0x91,
+  0x6d, 0x1d, 0x96, 0xb7, 0x15, 0x05, 0xbf, 0x7f, 0xbc, 0x4a, 0xc3, 0x85, 0x7f, 0xa5, 0xde, 0xb6,
+  0x85, 0x2b, 0xff, 0x66, 0x8b, 0xc0, 0x16, 0x82, 0xbd, 0x87, 0xc0, 0xad, 0x22, 0x6d, 0x1a, 0x6d,
+  0x7e, 0xd1, 0xd0, 0xa7, 0x7b, 0x8e, 0x41, 0x27, 0x34, 0xf2, 0xad, 0xb8, 0xe7, 0x71, 0xb0, 0xdf,
+  0xd9, 0x52, 0x11, 0xa0, 0xec, 0x13, 0xaa, 0x73, 0x53, 0xd9, 0xf1, 0x64, 0xa7, 0x94, 0xe3, 0xd9,
+  0x96, 0x81, 0xb9, 0x87, 0x19, 0xc3, 0x8a, 0x11, 0x17, 0x21, 0xdb, 0xf5, 0x4c, 0x94, 0x48, 0xcd,
+  0x8b, 0xe0, 0x61, 0x81, 0x25, 0xd4, 0x62, 0xe9, 0x0a, 0x6a, 0xc0, 0xea, 0x3a, 0x55, 0xaa, 0x23,
+  0x4e, 0x03, 0x78, 0xcd, 0x91, 0x6b, 0x96, 0xac, 0xf4, 0xc2, 0xe6, 0x46, 0x15, 0x94, 0x8f, 0xa7,
+  0x85, 0x6f, 0xa8, 0xb5, 0x54, 0xfb, 0xeb, 0xaf, 0x5c, 0x47, 0x85, 0x07, 0xef, 0x8d, 0x35, 0x0f,
+  0xbe, 0x44, 0xf8, 0x14, 0x58, 0x0e, 0x3f, 0x5c, 0x9e, 0xff, 0xdc, 0x41, 0x38, 0x50, 0x59, 0x6a,
+  0xd8, 0x45, 0x95, 0x2d, 0x20, 0xe4, 0xbf, 0x4b, 0xcd, 0xf1, 0x6b, 0xc2, 0x6e, 0x50, 0x95, 0xde,
+  0x29, 0xc2, 0x5a, 0xcf, 0xe0, 0x27, 0x71, 0xf7, 0x64, 0x15, 0xd8, 0x36, 0xcc, 0xc6, 0xae, 0xb8,
+  0xe2, 0xce, 0xec, 0x7b, 0xac, 0xec, 0x5d, 0x10, 0xcb, 0x25, 0x8f, 0x05, 0x2a, 0x5f, 0x7a, 0xa1,
+  0x21, 0xec, 0x23, 0x11, 0x7e, 0xaa, 0x4f, 0x59, 0x76, 0x2c, 0x18, 0x95, 0xcc, 0x88, 0xa9, 0x01,
+  0x46, 0xf9, 0x3d, 0x33, 0x8b, 0x10, 0x0f, 0x5b, 0xc1, 0xa0, 0x4b, 0x1d, 0xa1, 0x87, 0x47, 0x8a,
+  0xa6, 0xc6, 0x14, 0xfb, 0xd2, 0xa6, 0x4e, 0x6d, 0x04, 0x73, 0x52, 0xd1, 0x87, 0x83, 0x6a, 0xfe,
+  0x45, 0xd8, 0x11, 0x54, 0x1e, 0xf5, 0x32, 0x42, 0x15, 0xe4, 0x57, 0x63, 0x59, 0x8e, 0x1a, 0x38,
+  0x75, 0x72, 0x17, 0xb8, 0x0a, 0x53, 0x6d, 0xe8, 0xa8, 0x04, 0xbb, 0x02, 0xac, 0x52, 0x5a, 0xd7,
+  0xda, 0xd9, 0x79, 0x74, 0xce, 0x28, 0x3c, 0x4a, 0x3d, 0xce, 0xed, 0xcd, 0xef, 0x4a, 0xf1, 0x7e,
+  0x98, 0x23, 0xc9, 0xb4, 0x46, 0xd5, 0xfd, 0x8c, 0xee, 0x8a, 0xd0, 0xaf, 0x6f, 0x12, 0x81, 0x99,
+  0x79, 0x85, 0xd8, 0x2c, 0xb5, 0x75, 0xe4, 0x0b, 0x96, 0xcc, 0x68, 0x66, 0x0f, 0xed, 0x55, 0x14,
+  0xe6, 0xd7, 0x41, 0x01, 0x03, 0x2c, 0x95, 0xf1, 0x3d, 0xa5, 0x01, 0xe6, 0x7d, 0x64, 0x05, 0xfc,
+  0x8e, 0x9e, 0x54, 0x36, 0x57, 0xf1, 0x81, 0x38, 0x3b, 0xc8, 0x40, 0xbf, 0x6b, 0x3c, 0x1b, 0xe2,
+  0x51, 0x21, 0x5d, 0x02, 0x7f, 0xeb, 0xe4, 0xf7, 0xa0, 0x10, 0xf1, 0x9f, 0x26, 0x4b, 0x7e, 0x16,
+  0xa2, 0x6a, 0x69, 0x63, 0xb9, 0xd8, 0x64, 0xd2, 0x04, 0x31, 0x22, 0x20, 0xde, 0xd4, 0x42, 0x45,
+  0x34, 0x63, 0xd8, 0xef, 0xd0, 0xcd, 0xe3, 0x3d, 0xf4, 0xe9, 0x4c, 0x92, 0x9e, 0xd2, 0x76, 0xf9,
+  0x63, 0x5e, 0xeb, 0xa8, 0x8d, 0x85, 0xf6, 0x92, 0x2a, 0xb4, 0xad, 0x9a, 0xd0, 0x40, 0x73, 0xa2,
+  0x7d, 0xa1, 0x5a, 0x82, 0x85, 0x05, 0x25, 0x7c, 0xe3, 0x94, 0xfb, 0x06, 0x0e, 0x50, 0xa5, 0xc3,
+  0x6d, 0x86, 0x3b, 0xee, 0x3d, 0xf4, 0x50, 0xde, 0xce, 0x42, 0xa7, 0x98, 0x26, 0x2b, 0x58, 0xb6,
+  0xca, 0xda, 0xcb, 0xb8, 0xc0, 0x0a, 0xa3, 0x09, 0xa5, 0x0b, 0xd5, 0xaf, 0x9b, 0xe2, 0xeb, 0x8c,
+  0x21, 0x30, 0x3a, 0x8f, 0xa7, 0x87, 0xb2, 0xe3, 0x07, 0x6f, 0xd6, 0x85, 0x27, 0x8c, 0x68, 0xb7,
+  0x1f, 0x51, 0x05, 0xa1, 0x8f, 0xff, 0x8c, 0x5a, 0x35, 0xf6, 0x70, 0x38, 0xd8, 0x1d, 0xf3, 0xfc,
+  0x95, 0x61, 0x2c, 0xd7, 0x29, 0x0e, 0x7b, 0xbe, 0xfc, 0x7b, 0x6a, 0x44, 0xe5, 0xa5, 0x5b, 0x7e,
+  0xc3, 0x32, 0x2c, 0x23, 0xb6, 0xec, 0x7b, 0x86, 0x77, 0x71, 0xe7, 0xb4, 0x0e, 0xbe, 0xd3, 0x62,
+  0xe0, 0x7c, 0x61, 0x2f, 0xe2, 0xaa, 0xec, 0x45, 0xf1, 0x74, 0x1c, 0x0b, 0xa6, 0x9f, 0xdb, 0xaf,
+  0xf3, 0x3f, 0xee, 0xb7, 0xca, 0xe8, 0x20, 0x54, 0x71, 0xed, 0xdf, 0x63, 0x8b, 0xa8, 0x6a, 0x24,
+  0xbb, 0xac, 0xf9, 0x0c, 0x47, 0xed, 0xd8, 0x77, 0x3d, 0xc8, 0x30, 0x67, 0x69, 0x56, 0xdb, 0xec,
+  0x0c, 0x85, 0xc1, 0x84, 0x2b, 0x1c, 0x02, 0x7b, 0x13, 0x6a, 0x87, 0x76, 0x23, 0xdd, 0xa9, 0xce,
+  0x6e, 0xc5, 0xc5, 0xca, 0xf3, 0x97, 0x14, 0x05, 0x59, 0x7d, 0x8a, 0x73, 0x17, 0xbd, 0x7e, 0x8c,
+  0xb1, 0xd2, 0x27, 0x72, 0xa5, 0x22, 0x8e, 0xa7, 0x36, 0xb7, 0x94, 0x93, 0xbb, 0xb7, 0x47, 0x8c,
+  0xf5, 0xb7, 0x1f, 0xdd, 0x46, 0xe7, 0xf7, 0x83, 0xe5, 0xf3, 0x4d, 0xdf, 0x11, 0x4d, 0x19, 0x19,
+  0x4a, 0x99, 0xae, 0x43, 0x7a, 0x7e, 0x7f, 0xf7, 0x45, 0xa5, 0xd5, 0x63, 0xdf, 0xce, 0x3f, 0xef,
+  0x74, 0xec, 0x03, 0xec, 0xd8, 0xbf, 0xee, 0x3d, 0xb8, 0xf5, 0xcb, 0xc8, 0xc0, 0x18, 0x6b, 0x2f,
+  0x31, 0x51, 0xbb, 0x2f, 0xbe, 0x6e, 0xbf, 0xee, 0xdc, 0x50, 0x0b, 0x6f, 0x6f, 0xe9, 0x23, 0xfd,
+  0x09, 0x70, 0x4e, 0x03, 0xfa, 0xf7, 0x78, 0x1e, 0xcb, 0x5f, 0xda, 0x6e, 0xbd, 0xec, 0xf9, 0xf8,
+  0x9a, 0xf6, 0x59, 0x91, 0x1f, 0x15, 0x27, 0xd7, 0xc7, 0x93, 0x82, 0xe1, 0xe6, 0xb5, 0x50, 0x34,
+  0x90, 0xe8, 0xca, 0x34, 0xa2, 0xcb, 0x51, 0x44, 0xe7, 0x73, 0xc8, 0x5f, 0x70, 0xfd, 0xbb, 0x25,
+  0x33, 0xf7, 0x1f, 0x6e, 0xb7, 0x20, 0x6f, 0xd1, 0x28, 0xf7, 0xfa, 0x16, 0x47, 0x89, 0xad, 0x1f,
+  0x28, 0xba, 0x68, 0xc2, 0xb7, 0xa5, 0x6c, 0x22, 0x58, 0x60, 0x17, 0x31, 0x53, 0xce, 0x8c, 0xde,
+  0x42, 0xf9, 0xdc, 0xb5, 0xcc, 0x91, 0x64, 0x09, 0xd7, 0x11, 0x8f, 0xf1, 0x80, 0x9a, 0x3f, 0xd2,
+  0x77, 0xdf, 0x09, 0xc9, 0xd4, 0xae, 0xcb, 0xf1, 0xd8, 0x5b, 0x8a, 0x7a, 0xd4, 0x76, 0xc0, 0x89,
+  0xc7, 0xce, 0xc5, 0xc4, 0x85, 0xcf, 0xe8, 0xb5, 0xea, 0x58, 0xf4, 0x35, 0x92, 0x53, 0xd7, 0xcb,
+  0x75, 0xa7, 0xe7, 0xeb, 0xfb, 0xf7, 0xda, 0xce, 0x4b, 0x6c, 0x2e, 0x71, 0x39, 0x0f, 0xe2, 0xde,
+  0x83, 0x7f, 0xca, 0x4f, 0xcd, 0xdb, 0x17, 0x01, 0xc4, 0x51, 0x33, 0xcc, 0x94, 0x27, 0x20, 0xf4,
+  0xf9, 0x79, 0x08, 0x3d, 0x31, 0x35, 0x7e, 0x76, 0x61, 0x70, 0x37, 0x22, 0x6a, 0x95, 0xa6, 0x14,
+  0xe4, 0x2a, 0xac, 0x26, 0x7e, 0x57, 0xf8, 0x6a, 0xef, 0xe1, 0x73, 0x28, 0xe2, 0xed, 0x09, 0x8a,
+  0xe2, 0x19, 0xd0, 0x1b, 0x3d, 0x6c, 0xfb, 0xf9, 0x13, 0x5a, 0x49, 0x8f, 0xee, 0xe6, 0xa5, 0x06,
+  0x91, 0x5d, 0x21, 0x9e, 0xdd, 0x02, 0x20, 0x30, 0xb6, 0x37, 0x53, 0x8f, 0xa0, 0x0b, 0x5c, 0x5c,
+  0x0a, 0x3e, 0xd3, 0x70, 0x71, 0x81, 0x1f, 0x9e, 0x9c, 0x3e, 0x3b, 0x8f, 0x7b, 0x4d, 0xa2, 0xa7,
+  0x94, 0x54, 0xe5, 0x21, 0xe0, 0x69, 0x44, 0x42, 0xdb, 0xdd, 0xaf, 0xfa, 0xc2, 0xa2, 0x8d, 0xa2,
+  0xbf, 0xa1, 0xe0, 0x14, 0x6a, 0xa8, 0x10, 0x21, 0x43, 0x7e, 0xed, 0x44, 0xc3, 0x6a, 0x5e, 0x8a,
+  0xce, 0xec, 0x91, 0xd9, 0x1f, 0x12, 0xd7, 0x42, 0x71, 0x08, 0xe8, 0xef, 0x31, 0x5c, 0x95, 0x87,
+  0xca, 0x53, 0x3c, 0x93, 0x1e, 0x0e, 0x5e, 0xd1, 0xd1, 0x92, 0xc1, 0x0c, 0xab, 0xc5, 0x02, 0xfb,
+  0x92, 0xc2, 0xc3, 0x26, 0x9d, 0x66, 0xb9, 0xe5, 0x2c, 0x0e, 0xe0, 0xfe, 0x3c, 0xba, 0xe6, 0xca,
+  0x49, 0x8b, 0x61, 0x95, 0x41, 0x10, 0xcb, 0xe5, 0x3b, 0xaa, 0x8b, 0xe4, 0xc9, 0x3b, 0x4e, 0x07,
+  0x7b, 0x94, 0xe5, 0xae, 0x5c, 0x01, 0x43, 0xa4, 0xe9, 0x78, 0x4c, 0xfb, 0xd3, 0xdf, 0x6b, 0xe4,
+  0x2c, 0x17, 0x46, 0x5f, 0xe8, 0xa2, 0xa8, 0x63, 0x8f, 0xe1, 0xf9, 0x56, 0x3b, 0x87, 0x37, 0x77,
+  0xb6, 0x73, 0x47, 0x38, 0x9c, 0x0a, 0x43, 0x1e, 0x3a, 0x5a, 0x7b, 0xbc, 0xcf, 0x65, 0xf9, 0x83,
+  0x10, 0xd0, 0x75, 0xb1, 0x0e, 0x81, 0x26, 0x26, 0xf7, 0xd7, 0x9f, 0x99, 0x92, 0x4b, 0x7f, 0xd1,
+  0x80, 0x99, 0x85, 0xbb, 0x43, 0xca, 0xee, 0xc4, 0xdc, 0x1d, 0xe1, 0x9a, 0x2d, 0xb6, 0x7e, 0x3c,
+  0x6a, 0xc0, 0x15, 0xf9, 0x1a, 0x83, 0x2e, 0x55, 0x62, 0xdc, 0x56, 0x70, 0x7d, 0x66, 0x8f, 0x7b,
+  0x41, 0xbb, 0x94, 0xdd, 0xee, 0x7c, 0x1c, 0x7c, 0xaa, 0x0d, 0xe9, 0xc4, 0x8f, 0xb3, 0x39, 0xfe,
+  0x0a, 0x13, 0x94, 0x6f, 0x73, 0xe5, 0x3c, 0x8d, 0xf3, 0xb1, 0xb2, 0x3e, 0x8d, 0x3f, 0x59, 0xed,
+  0xf3, 0x6b, 0xee, 0x76, 0xe7, 0xa9, 0x72, 0x45, 0x06, 0x50, 0xbd, 0xa2, 0x8d, 0xdc, 0x4c, 0xc0,
+  0xd5, 0x44, 0xfc, 0x89, 0xb8, 0x3d, 0xab, 0xe3, 0xc0, 0x91, 0xc4, 0x3c, 0x92, 0x08, 0x82, 0x33,
+  0x0c, 0x44, 0x4e, 0xf5, 0xe3, 0xf5, 0xfb, 0x8b, 0x4e, 0xa3, 0x50, 0x89, 0x32, 0xbe, 0x08, 0x1c,
+  0x14, 0x5f, 0x19, 0x61, 0xac, 0x98, 0x1a, 0x04, 0x2c, 0xe2, 0xbb, 0xc5, 0xf1, 0x14, 0x12, 0xcf,
+  0x56, 0x15, 0xf9, 0xd4, 0x09, 0x97, 0x6a, 0x1a, 0xc1, 0x98, 0xd2, 0xb0, 0xb6, 0x4d, 0x9d, 0xde,
+  0x6e, 0x71, 0x53, 0x3b, 0x58, 0xad, 0x45, 0x8a, 0xc3, 0xca, 0x23, 0x85, 0x88, 0xfc, 0x5d, 0xb9,
+  0xaf, 0x2a, 0x06, 0xea, 0x7a, 0xc4, 0xdd, 0xc8, 0x3f, 0xec, 0xe7, 0x7f, 0x2b, 0x18, 0xf6, 0xdd,
+  0x9f, 0x2c, 0x87, 0x7d, 0xf7, 0x3f, 0x4e, 0xfe, 0x0b, 0x71, 0x5a, 0xde, 0x84, 0x89, 0x22, 0x00,
+  0x00,
+};
@@ -3,9 +3,15 @@
 #include <LoRa.h>
 #include <WiFi.h>
 #include <esp_system.h>
-#include <WebServer.h>
+#include <esp_timer.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 #include "ControlProtocol.h"
+#include "CommandMailbox.h"
 #include "LoRaBoards.h"
+#include "AsyncLog.h"
+#include "IndexPage.h"  // generated from web/index.html by scripts/embed_web.py
 
 // ---------- Board selection: LilyGO T-Beam (ESP32) ----------
 #if !defined(ESP32)
@@ -21,105 +27,140 @@
 #ifndef CONFIG_RADIO_BW
 #define CONFIG_RADIO_BW             125.0
 #endif
+#ifndef JOYSTICK_FRAME_GAP_MS
+#define JOYSTICK_FRAME_GAP_MS       30    // radio idle time between setpoint frames
+#endif
+#ifndef JOYSTICK_DEADZONE
+#define JOYSTICK_DEADZONE           12    // percent of stick travel read as Stop
+#endif
+#ifndef STATUS_EVENT_INTERVAL_MS
+#define STATUS_EVENT_INTERVAL_MS    500   // /events push period
+#endif
+#ifndef SEQUENCE_MAX_STEPS
+#define SEQUENCE_MAX_STEPS          32
+#endif
+#ifndef SEQUENCE_MAX_STEP_MS
+#define SEQUENCE_MAX_STEP_MS        60000
+#endif
 
 constexpr const char *kApSsid     = "TankController";
 constexpr const char *kApPassword = "tank12345";
 
-WebServer server(80);
+AsyncWebServer server(80);
+AsyncWebSocket joystickSocket("/ws");
+AsyncEventSource statusEvents("/events");
 
 uint8_t sequenceCounter = 0;
+uint32_t lastTxAt = 0;
+// Speeds set with the sliders, used by the buttons.
 uint8_t currentLeftSpeed = 255;
 uint8_t currentRightSpeed = 255;
-String lastState = "STOP";
-
-const char indexPage[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <meta charset="utf-8">
-  <meta name="viewport" content="width=device-width,initial-scale=1">
-  <title>Tank Controller TX</title>
-  <style>
-    body { font-family: sans-serif; margin: 0; padding: 2rem; background: #101820; color: #eee; }
-    h1 { margin-top: 0; }
-    button { width: 8rem; height: 3rem; margin: 0.5rem; font-size: 1rem; border: none; border-radius: 0.5rem; cursor: pointer; background: #ff7a18; color: #101820; }
-    button.stop { background: #ff3b30; color: #fff; }
-    #status { margin-top: 1.5rem; font-size: 1.1rem; }
-    .pad { display: grid; grid-template-columns: repeat(3, 8.5rem); grid-template-rows: repeat(3, 3.5rem); gap: 0.5rem; justify-content: center; margin-top: 2rem; }
-    .pad button { width: 100%; height: 100%; }
-    .speeds { margin-top: 2rem; display: flex; gap: 1.5rem; justify-content: center; }
-    .speeds label { display: flex; flex-direction: column; align-items: center; font-size: 0.9rem; }
-    input[type=range] { width: 200px; }
-    footer { margin-top: 3rem; font-size: 0.85rem; color: #aaa; text-align: center; }
-  </style>
-</head>
-<body>
-  <h1>T-Beam Tank Controller</h1>
-  <p>Tap a button to send a command over LoRa. Commands are AES-256 encrypted.</p>
-  <div class="pad">
-    <div></div>
-    <button data-cmd="forward">Forward</button>
-    <div></div>
-    <button data-cmd="left">Left</button>
-    <button class="stop" data-cmd="stop">Stop</button>
-    <button data-cmd="right">Right</button>
-    <div></div>
-    <button data-cmd="backward">Backward</button>
-    <div></div>
-  </div>
-  <div class="speeds">
-    <label>Left speed
-      <input id="leftSpeed" type="range" min="0" max="255" value="255">
-      <span id="leftValue">255</span>
-    </label>
-    <label>Right speed
-      <input id="rightSpeed" type="range" min="0" max="255" value="255">
-      <span id="rightValue">255</span>
-    </label>
-    <button data-cmd="speed" id="speedBtn">Set Speeds</button>
-  </div>
-  <div id="status">State: IDLE</div>
-  <footer>Connect to the TankController Wi-Fi network (password: tank12345).</footer>
-  <script>
-    const statusEl = document.getElementById('status');
-    const left = document.getElementById('leftSpeed');
-    const right = document.getElementById('rightSpeed');
-    const leftValue = document.getElementById('leftValue');
-    const rightValue = document.getElementById('rightValue');
-
-    function updateLabels() {
-      leftValue.textContent = left.value;
-      rightValue.textContent = right.value;
-    }
-    left.addEventListener('input', updateLabels);
-    right.addEventListener('input', updateLabels);
-    updateLabels();
-
-    async function sendCommand(cmd) {
-      statusEl.textContent = 'State: sending...';
-      const params = new URLSearchParams({ action: cmd });
-      if (cmd === 'speed') {
-        params.set('left', left.value);
-        params.set('right', right.value);
-      }
-      try {
-        const res = await fetch('/cmd', { method: 'POST', body: params });
-        if (!res.ok) throw new Error('HTTP ' + res.status);
-        const data = await res.json();
-        statusEl.textContent = `State: ${data.state}`;
-      } catch (err) {
-        statusEl.textContent = 'State: ERROR - ' + err.message;
-      }
-    }
-
-    document.querySelectorAll('button[data-cmd]').forEach(btn => {
-      btn.addEventListener('click', () => sendCommand(btn.dataset.cmd));
-    });
-    document.getElementById('speedBtn').addEventListener('click', () => sendCommand('speed'));
-  </script>
-</body>
-</html>
-)rawliteral";
+// Speeds of the last frame on air, repeated by heartbeats.
+uint8_t airLeftSpeed = 255;
+uint8_t airRightSpeed = 255;
+
+// Motion being driven from the web UI. While it is set, loop() repeats it as
+// a heartbeat so the receiver's link watchdog (kLinkTimeoutMs) keeps the
+// tank moving; Stop clears it and the tank idles without radio traffic.
+TankControl::Command activeMotion = TankControl::Command::Stop;
+uint32_t heartbeats = 0;
+uint64_t heartbeatAirtimeUs = 0;
+
+// Web -> radio hand-off. HTTP and WebSocket handlers run on the AsyncTCP
+// task and only post here; loop() owns the radio. Joystick setpoints arrive
+// far faster than LoRa carries them (~50 ms per frame at SF7), so the
+// mailbox keeps only the newest one, and a Stop is never coalesced away.
+struct WebCommand {
+  TankControl::Command command;
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  uint32_t receivedUs;  // micros() when the handler accepted it
+};
+
+CommandMailbox<WebCommand> mailbox;
+TaskHandle_t radioTask = nullptr;
+
+// Every control frame (heartbeats included) and, per web command, the
+// handler receive -> frame on air latency.
+struct RadioStats {
+  uint32_t frames = 0;
+  uint32_t failures = 0;
+  uint64_t airtimeUs = 0;
+  uint32_t commands = 0;
+  uint64_t latencySumUs = 0;
+  uint32_t latencyMaxUs = 0;
+};
+
+RadioStats radioStats;
+TankControl::Command airCommand = TankControl::Command::Stop;  // last command on air
+
+const uint32_t kFrameAirtimeUs = TankControl::timeOnAirUs(
+    7, CONFIG_RADIO_BW * 1000, 5, TankControl::kLinkPreambleSymbols, TankControl::kFrameSize,
+    TankControl::kImplicitHeader, true);
+const uint32_t kWakeFrameAirtimeUs = TankControl::timeOnAirUs(
+    7, CONFIG_RADIO_BW * 1000, 5, TankControl::kWakePreambleSymbols, TankControl::kFrameSize,
+    TankControl::kImplicitHeader, true);
+// Sized for a wake frame: a sequence may start after kWakeAfterIdleMs of
+// idle, and a step may last longer than that, so any step can be the one
+// whose frame carries the long preamble.
+const uint32_t kMinSequenceStepMs =
+    JOYSTICK_FRAME_GAP_MS + (kWakeFrameAirtimeUs + 999) / 1000;
+
+// Battery as last read from the PMU; percent is -1 when unknown.
+struct BatteryReading {
+  uint16_t millivolts = 0;
+  int8_t percent = -1;
+  bool charging = false;
+  uint32_t sampledAt = 0;
+};
+
+BatteryReading battery;
+uint32_t statusEventId = 0;
+
+// ---------- Timed command sequences (POST /sequence) ----------
+// Steps are started by an esp_timer against absolute due times (start +
+// sum of the previous durations), so timer latency never accumulates. Each
+// step is posted to the mailbox like any web command. A sequence always
+// ends with a Stop, and any manual command (a Stop above all) cancels it.
+// The mailbox keeps only the newest setpoint and frames go out at most one
+// per JOYSTICK_FRAME_GAP_MS + airtime, so a moving step shorter than that
+// would be coalesced away; handleSequence rejects it (kMinSequenceStepMs).
+// The timer is armed and stopped only under sequenceLock, and a callback
+// runs a step only once the current sequence's dueUs has passed: esp_timer
+// never fires early, so an earlier callback is one that was already
+// dispatched for a replaced sequence when startSequence stopped the timer.
+struct SequenceStep {
+  TankControl::Command command;
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  uint32_t durationMs;
+};
+
+enum class SequenceState : uint8_t { Idle, Running, Done, Cancelled };
+
+struct Sequence {
+  SequenceStep steps[SEQUENCE_MAX_STEPS + 1];  // + the closing Stop
+  uint8_t count = 0;
+  uint8_t next = 0;             // next step to start
+  uint32_t id = 0;
+  SequenceState state = SequenceState::Idle;
+  uint64_t dueUs = 0;           // esp_timer time the next step is due
+  uint32_t maxLateUs = 0;       // worst timer lateness in this sequence
+  uint32_t revision = 0;        // bumped on every change, for /events
+};
+
+portMUX_TYPE sequenceLock = portMUX_INITIALIZER_UNLOCKED;
+Sequence sequence;
+esp_timer_handle_t sequenceTimer = nullptr;
+
+// GET / accounting: full gzip transfers vs. 304 revalidations.
+struct PageStats {
+  uint32_t full = 0;
+  uint32_t notModified = 0;
+  uint64_t bodyBytes = 0;
+};
+
+PageStats pageStats;
 
 TankControl::Command parseCommand(const String &action) {
   if (action == "forward") return TankControl::Command::Forward;
@@ -130,33 +171,155 @@ TankControl::Command parseCommand(const String &action) {
   return TankControl::Command::Stop;
 }
 
+const char *stateName(TankControl::Command cmd) {
+  switch (cmd) {
+    case TankControl::Command::Forward: return "FORWARD";
+    case TankControl::Command::Backward: return "BACKWARD";
+    case TankControl::Command::Left: return "LEFT";
+    case TankControl::Command::Right: return "RIGHT";
+    case TankControl::Command::SetSpeed: return "SPEED";
+    default: return "STOP";
+  }
+}
+
+void enqueueCommand(TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed) {
+  mailbox.post(WebCommand{cmd, leftSpeed, rightSpeed, static_cast<uint32_t>(micros())},
+               cmd == TankControl::Command::Stop);
+}
+
+void wakeRadio() {
+  if (radioTask) {
+    xTaskNotifyGive(radioTask);
+  }
+}
+
+void postCommand(TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed) {
+  enqueueCommand(cmd, leftSpeed, rightSpeed);
+  wakeRadio();
+}
+
+// Posts the next step and arms the timer for the one after. Caller holds
+// sequenceLock and has checked the sequence is running.
+void startNextStepLocked(uint64_t now) {
+  if (now > sequence.dueUs) {
+    sequence.maxLateUs = max(sequence.maxLateUs, static_cast<uint32_t>(now - sequence.dueUs));
+  }
+  const SequenceStep step = sequence.steps[sequence.next++];
+  if (sequence.next < sequence.count) {
+    sequence.dueUs += static_cast<uint64_t>(step.durationMs) * 1000;
+    esp_timer_start_once(sequenceTimer, sequence.dueUs > now ? sequence.dueUs - now : 1);
+  } else {
+    sequence.state = SequenceState::Done;
+  }
+  ++sequence.revision;
+  // Posted under the lock: a manual command cancels the sequence (under the
+  // same lock) before posting, so a step can never land behind its Stop.
+  enqueueCommand(step.command, step.leftSpeed, step.rightSpeed);
+}
+
+void sequenceTimerFired(void *) {
+  portENTER_CRITICAL(&sequenceLock);
+  const uint64_t now = esp_timer_get_time();
+  const bool due = sequence.state == SequenceState::Running && now >= sequence.dueUs;
+  if (due) {
+    startNextStepLocked(now);
+  }
+  portEXIT_CRITICAL(&sequenceLock);
+  if (due) {
+    wakeRadio();
+  }
+}
+
+// Replaces any running sequence and starts the first step right away.
+uint32_t startSequence(const SequenceStep *steps, uint8_t count) {
+  portENTER_CRITICAL(&sequenceLock);
+  esp_timer_stop(sequenceTimer);
+  memcpy(sequence.steps, steps, count * sizeof(SequenceStep));
+  sequence.count = count;
+  sequence.next = 0;
+  const uint32_t id = ++sequence.id;
+  sequence.state = SequenceState::Running;
+  const uint64_t now = esp_timer_get_time();
+  sequence.dueUs = now;
+  sequence.maxLateUs = 0;
+  startNextStepLocked(now);
+  portEXIT_CRITICAL(&sequenceLock);
+  wakeRadio();
+  return id;
+}
+
+bool cancelSequence() {
+  bool cancelled = false;
+  portENTER_CRITICAL(&sequenceLock);
+  if (sequence.state == SequenceState::Running) {
+    sequence.state = SequenceState::Cancelled;
+    ++sequence.revision;
+    esp_timer_stop(sequenceTimer);
+    cancelled = true;
+  }
+  portEXIT_CRITICAL(&sequenceLock);
+  return cancelled;
+}
+
+// Joystick position (x right, y forward, -100..100 each) to a tank command.
+// A mostly vertical stick drives forward/backward with the track speeds
+// mixed for steering, a mostly horizontal one spins in place, and the
+// centre is Stop.
+void postJoystick(int x, int y) {
+  cancelSequence();
+  const int ax = abs(x);
+  const int ay = abs(y);
+  if (max(ax, ay) < JOYSTICK_DEADZONE) {
+    postCommand(TankControl::Command::Stop, 0, 0);
+    return;
+  }
+  auto toSpeed = [](int percent) {
+    return static_cast<uint8_t>(constrain(percent, 0, 100) * 255 / 100);
+  };
+  if (ay >= ax) {
+    postCommand(y > 0 ? TankControl::Command::Forward : TankControl::Command::Backward,
+                toSpeed(ay + x), toSpeed(ay - x));
+  } else {
+    postCommand(x > 0 ? TankControl::Command::Right : TankControl::Command::Left,
+                toSpeed(ax), toSpeed(ax));
+  }
+}
+
 bool sendLoRaFrame(TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed) {
   TankControl::ControlFrame frame;
   TankControl::initFrame(frame, cmd, leftSpeed, rightSpeed, sequenceCounter++);
 
   uint8_t encrypted[TankControl::kFrameSize];
   if (!TankControl::encryptFrame(frame, encrypted, sizeof(encrypted))) {
-    Serial.println("Encrypt failed");
+    LOG_E("Encrypt failed");
     return false;
   }
 
+  // After a long idle the receiver may be parked on a CAD duty cycle;
+  // stretch the preamble so it spans one CAD period.
+  const bool wake = lastTxAt == 0 || millis() - lastTxAt >= TankControl::kWakeAfterIdleMs;
+
   LoRa.idle();
-  LoRa.beginPacket();
+  if (wake) {
+    LoRa.setPreambleLength(TankControl::kWakePreambleSymbols);
+  }
+  LoRa.beginPacket(TankControl::kImplicitHeader);
   LoRa.write(encrypted, sizeof(encrypted));
   bool ok = LoRa.endPacket() == 1;
+  if (wake) {
+    LoRa.setPreambleLength(TankControl::kLinkPreambleSymbols);
+  }
   LoRa.receive();
 
   if (ok) {
-    Serial.print("TX -> cmd=");
-    Serial.print(static_cast<int>(frame.command));
-    Serial.print(" seq=");
-    Serial.print(frame.sequence);
-    Serial.print(" left=");
-    Serial.print(frame.leftSpeed);
-    Serial.print(" right=");
-    Serial.println(frame.rightSpeed);
+    lastTxAt = millis();
+    ++radioStats.frames;
+    radioStats.airtimeUs += wake ? kWakeFrameAirtimeUs : kFrameAirtimeUs;
+    LOG_D("%sTX -> cmd=%d seq=%u left=%u right=%u", wake ? "(wake preamble) " : "",
+          static_cast<int>(frame.command), frame.sequence, frame.leftSpeed, frame.rightSpeed);
   } else {
-    Serial.println("LoRa TX failed");
+    ++radioStats.failures;
+    LOG_E("LoRa TX failed");
   }
   return ok;
 }
@@ -168,68 +331,285 @@ void sendSpectrumTestBurst() {
     payload[i] = static_cast<uint8_t>(random(0, 256));
   }
 
-  Serial.println("Sending LoRa spectrum test burst...");
+  LOG_I("Sending LoRa spectrum test burst...");
   LoRa.idle();
   LoRa.beginPacket();
   LoRa.write(payload, sizeof(payload));
   if (LoRa.endPacket() == 1) {
-    Serial.print("Burst length: ");
-    Serial.println(sizeof(payload));
+    LOG_I("Burst length: %u", static_cast<unsigned>(sizeof(payload)));
   } else {
-    Serial.println("Spectrum test burst failed to transmit");
+    LOG_W("Spectrum test burst failed to transmit");
   }
   LoRa.receive();
 }
 
-void handleWebRoot() {
-  server.send_P(200, "text/html", indexPage);
+// The page is gzip-compressed at build time (IndexPage.h) and served as is;
+// every browser that can drive the UI accepts gzip. Browsers keep it and
+// revalidate with If-None-Match, which costs a header-only 304.
+void handleWebRoot(AsyncWebServerRequest *request) {
+  const bool notModified = request->hasHeader("If-None-Match") &&
+                           request->getHeader("If-None-Match")->value() == kIndexPageEtag;
+  AsyncWebServerResponse *response;
+  if (notModified) {
+    ++pageStats.notModified;
+    response = request->beginResponse(304);
+  } else {
+    ++pageStats.full;
+    pageStats.bodyBytes += kIndexPageGzSize;
+    response = request->beginResponse(200, "text/html", kIndexPageGz, kIndexPageGzSize);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", kIndexPageEtag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+  LOG_D("GET / -> %s | full=%lu notModified=%lu body=%lluB (uncompressed would be %lluB)",
+        notModified ? "304" : "200 gzip", static_cast<unsigned long>(pageStats.full),
+        static_cast<unsigned long>(pageStats.notModified),
+        static_cast<unsigned long long>(pageStats.bodyBytes),
+        static_cast<unsigned long long>(pageStats.full + pageStats.notModified) *
+            kIndexPageHtmlSize);
 }
 
-void handleWebCommand() {
-  if (!server.hasArg("action")) {
-    server.send(400, "application/json", "{\"error\":\"missing action\"}");
+// Buttons and sliders. The reply only confirms the command was queued; what
+// actually went on air is pushed to the page over the WebSocket.
+void handleWebCommand(AsyncWebServerRequest *request) {
+  if (!request->hasParam("action", true)) {
+    request->send(400, "application/json", "{\"error\":\"missing action\"}");
     return;
   }
 
-  String action = server.arg("action");
+  String action = request->getParam("action", true)->value();
   action.toLowerCase();
   TankControl::Command cmd = parseCommand(action);
-  bool ok = true;
 
   if (cmd == TankControl::Command::SetSpeed) {
-    int left = server.hasArg("left") ? server.arg("left").toInt() : currentLeftSpeed;
-    int right = server.hasArg("right") ? server.arg("right").toInt() : currentRightSpeed;
-    left = constrain(left, 0, 255);
-    right = constrain(right, 0, 255);
-    currentLeftSpeed = static_cast<uint8_t>(left);
-    currentRightSpeed = static_cast<uint8_t>(right);
-    ok = sendLoRaFrame(cmd, currentLeftSpeed, currentRightSpeed);
-    if (ok) {
-      lastState = "SPEED";
+    int left = request->hasParam("left", true) ? request->getParam("left", true)->value().toInt()
+                                               : currentLeftSpeed;
+    int right = request->hasParam("right", true) ? request->getParam("right", true)->value().toInt()
+                                                 : currentRightSpeed;
+    currentLeftSpeed = static_cast<uint8_t>(constrain(left, 0, 255));
+    currentRightSpeed = static_cast<uint8_t>(constrain(right, 0, 255));
+  }
+  cancelSequence();
+  postCommand(cmd, currentLeftSpeed, currentRightSpeed);
+
+  String body = "{\"state\":\"";
+  body += stateName(cmd);
+  body += "\"}";
+  request->send(200, "application/json", body);
+}
+
+// POST /sequence with a JSON body such as
+//   {"steps":[{"action":"forward","ms":2000,"left":200,"right":200},
+//             {"action":"right","ms":700},{"action":"stop"}]}
+// Actions are the /cmd ones; speeds default to the slider speeds, and any
+// step but a stop must last at least kMinSequenceStepMs. The body is
+// collected by handleSequenceBody and parsed once complete.
+constexpr size_t kMaxSequenceBody = 2048;
+
+void handleSequenceBody(AsyncWebServerRequest *request, uint8_t *data, size_t len,
+                        size_t index, size_t total) {
+  if (total > kMaxSequenceBody) {
+    return;
+  }
+  if (index == 0) {
+    request->_tempObject = malloc(total + 1);
+  }
+  char *body = static_cast<char *>(request->_tempObject);
+  if (body) {
+    memcpy(body + index, data, len);
+    body[index + len] = '\0';
+  }
+}
+
+void handleSequence(AsyncWebServerRequest *request) {
+  const char *body = static_cast<const char *>(request->_tempObject);
+  if (!body) {
+    request->send(400, "application/json", "{\"error\":\"missing or oversized body\"}");
+    return;
+  }
+  JsonDocument doc;
+  if (deserializeJson(doc, body)) {
+    request->send(400, "application/json", "{\"error\":\"invalid json\"}");
+    return;
+  }
+  JsonArrayConst list = doc["steps"];
+  if (list.size() == 0 || list.size() > SEQUENCE_MAX_STEPS) {
+    request->send(400, "application/json", "{\"error\":\"no steps or too many\"}");
+    return;
+  }
+
+  SequenceStep steps[SEQUENCE_MAX_STEPS + 1];
+  uint8_t count = 0;
+  uint32_t totalMs = 0;
+  for (JsonObjectConst item : list) {
+    String action = item["action"] | "";
+    action.toLowerCase();
+    const TankControl::Command cmd = parseCommand(action);
+    const uint32_t durationMs = item["ms"] | 0;
+    if ((cmd == TankControl::Command::Stop && action != "stop") ||
+        durationMs > SEQUENCE_MAX_STEP_MS ||
+        (cmd != TankControl::Command::Stop && durationMs < kMinSequenceStepMs)) {
+      request->send(400, "application/json", "{\"error\":\"bad step\"}");
+      return;
     }
-  } else {
-    ok = sendLoRaFrame(cmd, currentLeftSpeed, currentRightSpeed);
-    if (ok) {
-      switch (cmd) {
-        case TankControl::Command::Forward: lastState = "FORWARD"; break;
-        case TankControl::Command::Backward: lastState = "BACKWARD"; break;
-        case TankControl::Command::Left: lastState = "LEFT"; break;
-        case TankControl::Command::Right: lastState = "RIGHT"; break;
-        case TankControl::Command::Stop: lastState = "STOP"; break;
-        default: break;
+    const int left = item["left"] | static_cast<int>(currentLeftSpeed);
+    const int right = item["right"] | static_cast<int>(currentRightSpeed);
+    steps[count++] = SequenceStep{cmd, static_cast<uint8_t>(constrain(left, 0, 255)),
+                                  static_cast<uint8_t>(constrain(right, 0, 255)), durationMs};
+    totalMs += durationMs;
+  }
+  if (steps[count - 1].command != TankControl::Command::Stop) {
+    steps[count++] = SequenceStep{TankControl::Command::Stop, 0, 0, 0};
+  }
+
+  const uint32_t id = startSequence(steps, count);
+  LOG_I("Sequence #%lu started: %u steps, %lu ms", static_cast<unsigned long>(id), count,
+        static_cast<unsigned long>(totalMs));
+  char reply[64];
+  snprintf(reply, sizeof(reply), "{\"id\":%lu,\"steps\":%u,\"durationMs\":%lu}",
+           static_cast<unsigned long>(id), count, static_cast<unsigned long>(totalMs));
+  request->send(202, "application/json", reply);
+}
+
+// Joystick channel: each binary message is the stick position as two
+// signed bytes, x then y. A client that goes away stops the tank, since it
+// may have been holding the stick.
+void handleJoystickSocket(AsyncWebSocket *socket, AsyncWebSocketClient *client,
+                          AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  switch (type) {
+    case WS_EVT_CONNECT:
+      LOG_I("Joystick client #%lu connected", static_cast<unsigned long>(client->id()));
+      break;
+    case WS_EVT_DISCONNECT:
+      LOG_I("Joystick client #%lu gone -> STOP", static_cast<unsigned long>(client->id()));
+      cancelSequence();
+      postCommand(TankControl::Command::Stop, 0, 0);
+      break;
+    case WS_EVT_DATA: {
+      const AwsFrameInfo *info = static_cast<AwsFrameInfo *>(arg);
+      if (info->opcode == WS_BINARY && info->final && info->index == 0 && info->len == 2 &&
+          len == 2) {
+        postJoystick(static_cast<int8_t>(data[0]), static_cast<int8_t>(data[1]));
       }
+      break;
     }
+    default:
+      break;
   }
+}
 
-  if (!ok) {
-    server.send(500, "application/json", "{\"error\":\"lora tx failed\"}");
+void broadcastResult(const WebCommand &cmd, bool ok, uint32_t latencyUs) {
+  if (joystickSocket.count() == 0) {
     return;
   }
+  char message[96];
+  snprintf(message, sizeof(message),
+           "{\"state\":\"%s\",\"left\":%u,\"right\":%u,\"ok\":%s,\"latencyUs\":%lu}",
+           stateName(cmd.command), cmd.leftSpeed, cmd.rightSpeed, ok ? "true" : "false",
+           static_cast<unsigned long>(latencyUs));
+  joystickSocket.textAll(message);
+}
 
-  String body = "{\"state\":\"";
-  body += lastState;
-  body += "\"}";
-  server.send(200, "application/json", body);
+// Transmits the next pending command: a Stop at once, a setpoint no sooner
+// than JOYSTICK_FRAME_GAP_MS after the previous frame left the air.
+void pumpRadio() {
+  if (!mailbox.stopPending() && millis() - lastTxAt < JOYSTICK_FRAME_GAP_MS) {
+    return;
+  }
+  WebCommand next;
+  if (!mailbox.take(next)) {
+    return;
+  }
+  // A Stop ends the heartbeats when it is taken, not when it is on air: a
+  // failed Stop must not leave sendHeartbeat() repeating the old motion. It
+  // goes back to the mailbox until it is sent or a newer command replaces it.
+  const bool stop = next.command == TankControl::Command::Stop;
+  if (stop) {
+    activeMotion = TankControl::Command::Stop;
+  }
+  if (!sendLoRaFrame(next.command, next.leftSpeed, next.rightSpeed)) {
+    if (stop && mailbox.putBackStop(next)) {
+      LOG_W("Stop not sent; retrying");
+    }
+    broadcastResult(next, false, 0);
+    return;
+  }
+  const uint32_t latencyUs = static_cast<uint32_t>(micros()) - next.receivedUs;
+  ++radioStats.commands;
+  airCommand = next.command;
+  radioStats.latencySumUs += latencyUs;
+  radioStats.latencyMaxUs = max(radioStats.latencyMaxUs, latencyUs);
+  airLeftSpeed = next.leftSpeed;
+  airRightSpeed = next.rightSpeed;
+  if (next.command != TankControl::Command::SetSpeed) {
+    activeMotion = next.command;
+  }
+  broadcastResult(next, true, latencyUs);
+}
+
+void logRadioStats() {
+  static uint32_t lastLogAt = 0;
+  static uint32_t loggedFrames = 0;
+  if (millis() - lastLogAt < 10000 || radioStats.commands == loggedFrames) {
+    return;
+  }
+  lastLogAt = millis();
+  loggedFrames = radioStats.commands;
+  LOG_I("Radio: frames=%lu failed=%lu coalesced=%lu | web->air avg=%.1fms max=%.1fms",
+        static_cast<unsigned long>(radioStats.frames),
+        static_cast<unsigned long>(radioStats.failures),
+        static_cast<unsigned long>(mailbox.superseded()),
+        radioStats.latencySumUs / 1000.0 / radioStats.commands, radioStats.latencyMaxUs / 1000.0);
+}
+
+// PMU reads are I2C transactions, so they are spaced out.
+void sampleBattery(uint32_t now) {
+#ifdef HAS_PMU
+  if (!PMU || (battery.sampledAt != 0 && now - battery.sampledAt < 5000)) {
+    return;
+  }
+  battery.sampledAt = now;
+  battery.millivolts = PMU->getBattVoltage();
+  battery.percent = PMU->isBatteryConnect() ? PMU->getBatteryPercent() : -1;
+  battery.charging = PMU->isCharging();
+#else
+  (void)now;
+#endif
+}
+
+// Live status for /events. One message is formatted per interval and
+// AsyncEventSource queues that same message to every viewer without waiting
+// on the network; when the viewers' queues back up the update is skipped,
+// so a slow phone never holds up the radio.
+void publishStatus() {
+  static uint32_t lastAt = 0;
+  static uint64_t lastAirtimeUs = 0;
+  const uint32_t now = millis();
+  if (now - lastAt < STATUS_EVENT_INTERVAL_MS) {
+    return;
+  }
+  const float airtimePercent = (radioStats.airtimeUs - lastAirtimeUs) / 10.0f / (now - lastAt);
+  lastAt = now;
+  lastAirtimeUs = radioStats.airtimeUs;
+  sampleBattery(now);
+  if (statusEvents.count() == 0 || statusEvents.avgPacketsWaiting() > 4) {
+    return;
+  }
+
+  char message[256];
+  snprintf(message, sizeof(message),
+           "{\"state\":\"%s\",\"left\":%u,\"right\":%u,\"txOk\":%lu,\"txFail\":%lu,"
+           "\"heartbeats\":%lu,\"coalesced\":%lu,\"pending\":%s,\"airPct\":%.1f,"
+           "\"lastTxMs\":%lu,\"battMv\":%u,\"battPct\":%d,\"charging\":%s}",
+           stateName(airCommand), airLeftSpeed, airRightSpeed,
+           static_cast<unsigned long>(radioStats.frames),
+           static_cast<unsigned long>(radioStats.failures),
+           static_cast<unsigned long>(heartbeats), static_cast<unsigned long>(mailbox.superseded()),
+           mailbox.pending() ? "true" : "false", airtimePercent,
+           static_cast<unsigned long>(lastTxAt ? now - lastTxAt : 0), battery.millivolts,
+           battery.percent, battery.charging ? "true" : "false");
+  statusEvents.send(message, "status", ++statusEventId);
 }
 
 bool beginLoRa() {
@@ -242,7 +622,7 @@ bool beginLoRa() {
 #endif
 
   if (!LoRa.begin(CONFIG_RADIO_FREQ * 1000000)) {
-    Serial.println("LoRa init failed. Check wiring.");
+    LOG_E("LoRa init failed. Check wiring.");
     return false;
   }
 
@@ -251,9 +631,12 @@ bool beginLoRa() {
   LoRa.setSpreadingFactor(7);
   LoRa.setCodingRate4(5);
   LoRa.enableCrc();
+  LoRa.setPreambleLength(TankControl::kLinkPreambleSymbols);
   LoRa.receive();
 
-  Serial.println("LoRa radio ready (TX).");
+  LOG_I("LoRa radio ready (TX).");
+  AsyncLog::flush();  // the link profile goes straight to Serial
+  TankControl::printLinkProfile(Serial, 7, CONFIG_RADIO_BW * 1000, 5);
   return true;
 }
 
@@ -263,13 +646,14 @@ void setup() {
   while (!Serial) { delay(10); }
 
   Serial.begin(115200);
+  AsyncLog::begin();
 
-  Serial.println("\nT-Beam TX | LoRa Tank Controller");
-  Serial.println("Hosting Wi-Fi AP + Web UI, relaying commands over AES-256 LoRa.");
+  LOG_I("\nT-Beam TX | LoRa Tank Controller");
+  LOG_I("Hosting Wi-Fi AP + Web UI, relaying commands over AES-256 LoRa.");
 
   bool radioReady = beginLoRa();
   if (!radioReady) {
-    Serial.println("LoRa setup failed; reboot after checking the radio module.");
+    LOG_E("LoRa setup failed; reboot after checking the radio module.");
   } else {
     randomSeed(esp_random());
     sendSpectrumTestBurst();
@@ -277,25 +661,96 @@ void setup() {
 
   WiFi.mode(WIFI_AP);
   if (WiFi.softAP(kApSsid, kApPassword)) {
-    Serial.print("SoftAP ready. SSID: ");
-    Serial.print(kApSsid);
-    Serial.print("  Password: ");
-    Serial.println(kApPassword);
-    Serial.print("AP IP address: ");
-    Serial.println(WiFi.softAPIP());
+    LOG_I("SoftAP ready. SSID: %s  Password: %s", kApSsid, kApPassword);
+    LOG_I("AP IP address: %s", WiFi.softAPIP().toString().c_str());
   } else {
-    Serial.println("Failed to start SoftAP.");
+    LOG_E("Failed to start SoftAP.");
   }
 
+  radioTask = xTaskGetCurrentTaskHandle();
+  esp_timer_create_args_t sequenceTimerArgs = {};
+  sequenceTimerArgs.callback = sequenceTimerFired;
+  sequenceTimerArgs.name = "sequence";
+  esp_timer_create(&sequenceTimerArgs, &sequenceTimer);
+  joystickSocket.onEvent(handleJoystickSocket);
+  server.addHandler(&joystickSocket);
+  server.addHandler(&statusEvents);
   server.on("/", HTTP_GET, handleWebRoot);
   server.on("/cmd", HTTP_POST, handleWebCommand);
-  server.onNotFound([]() {
-    server.send(404, "application/json", "{\"error\":\"not found\"}");
+  server.on("/sequence", HTTP_POST, handleSequence, nullptr, handleSequenceBody);
+  server.onNotFound([](AsyncWebServerRequest *request) {
+    request->send(404, "application/json", "{\"error\":\"not found\"}");
   });
   server.begin();
-  Serial.println("Web UI ready at http://" + WiFi.softAPIP().toString());
+  LOG_I("Web UI ready at http://%s", WiFi.softAPIP().toString().c_str());
+}
+
+void sendHeartbeat() {
+  if (!TankControl::isMotion(activeMotion) ||
+      millis() - lastTxAt < TankControl::kHeartbeatIntervalMs) {
+    return;
+  }
+  if (!sendLoRaFrame(activeMotion, airLeftSpeed, airRightSpeed)) {
+    return;
+  }
+  ++heartbeats;
+  heartbeatAirtimeUs += kFrameAirtimeUs;
+  if (heartbeats % 100 == 0) {
+    LOG_I("Heartbeats: %lu (%lu ms on air)", static_cast<unsigned long>(heartbeats),
+          static_cast<unsigned long>(heartbeatAirtimeUs / 1000));
+  }
+}
+
+const char *sequenceStateName(SequenceState state) {
+  switch (state) {
+    case SequenceState::Running: return "running";
+    case SequenceState::Done: return "done";
+    case SequenceState::Cancelled: return "cancelled";
+    default: return "idle";
+  }
+}
+
+// Sequence progress for /events: one "sequence" event whenever a step
+// starts, the sequence completes or it is cancelled.
+void publishSequence() {
+  static uint32_t publishedRevision = 0;
+  portENTER_CRITICAL(&sequenceLock);
+  const uint32_t revision = sequence.revision;
+  const uint32_t id = sequence.id;
+  const SequenceState state = sequence.state;
+  const uint8_t started = sequence.next;
+  const uint8_t count = sequence.count;
+  const TankControl::Command command =
+      started > 0 ? sequence.steps[started - 1].command : TankControl::Command::Stop;
+  const uint32_t maxLateUs = sequence.maxLateUs;
+  portEXIT_CRITICAL(&sequenceLock);
+  if (revision == publishedRevision) {
+    return;
+  }
+  publishedRevision = revision;
+  if (state != SequenceState::Running) {
+    LOG_I("Sequence #%lu %s after %u/%u steps (timer late max %lu us)",
+          static_cast<unsigned long>(id), sequenceStateName(state), started, count,
+          static_cast<unsigned long>(maxLateUs));
+  }
+  if (statusEvents.count() == 0) {
+    return;
+  }
+  char message[128];
+  snprintf(message, sizeof(message),
+           "{\"id\":%lu,\"state\":\"%s\",\"step\":%u,\"steps\":%u,\"action\":\"%s\","
+           "\"maxLateUs\":%lu}",
+           static_cast<unsigned long>(id), sequenceStateName(state), started, count,
+           stateName(command), static_cast<unsigned long>(maxLateUs));
+  statusEvents.send(message, "sequence", ++statusEventId);
 }
 
 void loop() {
-  server.handleClient();
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(mailbox.pending() ? 2 : 20));
+  pumpRadio();
+  sendHeartbeat();
+  logRadioStats();
+  publishStatus();
+  publishSequence();
+  joystickSocket.cleanupClients();
 }
@@ -0,0 +1,119 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// JSON side of the gateway <-> server.py WebSocket hop (BridgeProtocol.h is
+// the binary side): the bridge's text messages, and the per-command and
+// per-packet messages the gateway sends back. main.cpp goes through these
+// with its per-task JsonArena, and test/host runs the same code, so nothing
+// here reads gateway state. Writers return the length put in `out`, or 0
+// when the message does not fit (the caller must not send it).
+namespace BridgeJson {
+
+// A text message from the bridge. Strings point into the document.
+struct Inbound {
+  const char *type;      // "proto", "dump", ...; null for tank commands
+  const char *proto;     // framing accepted by the bridge; "" if absent
+  const char *command;   // token ("forward", "estop", ...); null if absent
+  const char *tankId;    // null: the first tank
+  bool hasLeftSpeed;
+  bool hasRightSpeed;
+  uint8_t leftSpeed;     // defaultSpeed when absent or not a number
+  uint8_t rightSpeed;
+  uint16_t sequence;     // "seq", 0 if absent
+};
+
+inline DeserializationError parseInbound(JsonDocument &doc, const char *json,
+                                         uint8_t defaultSpeed, Inbound &out) {
+  const DeserializationError err = deserializeJson(doc, json);
+  if (err) {
+    return err;
+  }
+  out.type = doc["type"];
+  out.proto = doc["proto"] | "";
+  out.command = doc["command"];
+  out.tankId = doc["tankId"];
+  out.hasLeftSpeed = doc.containsKey("leftSpeed");
+  out.hasRightSpeed = doc.containsKey("rightSpeed");
+  out.leftSpeed = uint8_t(doc["leftSpeed"] | defaultSpeed);
+  out.rightSpeed = uint8_t(doc["rightSpeed"] | defaultSpeed);
+  out.sequence = uint16_t(doc["seq"] | 0);
+  return err;
+}
+
+// Sent once a command's frame is on air. Built with snprintf: the ack is
+// the most frequent message and its layout never changes.
+struct Ack {
+  const char *tankId;
+  const char *command;    // state name
+  uint16_t sequence;      // the bridge's "seq"
+  uint8_t radioSequence;
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  uint32_t gatewayUs;     // WebSocket receive -> LoRa TX done
+};
+
+inline size_t writeAck(const Ack &ack, char *out, size_t size) {
+  const int length = snprintf(out, size,
+                              "{\"type\":\"tx_ack\",\"tankId\":\"%s\",\"command\":\"%s\","
+                              "\"seq\":%u,\"radioSeq\":%u,\"leftSpeed\":%u,\"rightSpeed\":%u,"
+                              "\"gwUs\":%lu}",
+                              ack.tankId, ack.command, ack.sequence, ack.radioSequence,
+                              ack.leftSpeed, ack.rightSpeed,
+                              static_cast<unsigned long>(ack.gatewayUs));
+  return length <= 0 || static_cast<size_t>(length) >= size ? 0 : static_cast<size_t>(length);
+}
+
+inline size_t serialize(const JsonDocument &doc, char *out, size_t size) {
+  const size_t length = serializeJson(doc, out, size);
+  return length == 0 || length >= size ? 0 : length;
+}
+
+// The gateway fields that changed past their StatusDelta threshold.
+struct Delta {
+  const char *tankId;
+  bool hasWifiRssi;
+  int8_t wifiRssi;
+  bool hasFreeHeap;
+  uint32_t freeHeap;
+  bool hasSuperseded;
+  uint32_t superseded;
+};
+
+inline size_t writeDelta(JsonDocument &doc, const Delta &delta, char *out, size_t size) {
+  doc["type"] = "delta";
+  doc["tankId"] = delta.tankId;
+  if (delta.hasWifiRssi) {
+    doc["wifiRssi"] = delta.wifiRssi;
+  }
+  if (delta.hasFreeHeap) {
+    doc["freeHeap"] = delta.freeHeap;
+  }
+  if (delta.hasSuperseded) {
+    doc["superseded"] = delta.superseded;
+  }
+  return serialize(doc, out, size);
+}
+
+// A sensor node packet heard on the shared radio; payload is its text.
+struct Sensor {
+  const char *tankId;
+  int rssi;
+  float snr;
+  long frequencyError;
+  uint32_t receivedAtMs;
+  const char *payload;
+};
+
+inline size_t writeSensor(JsonDocument &doc, const Sensor &sensor, char *out, size_t size) {
+  doc["type"] = "sensor";
+  doc["tankId"] = sensor.tankId;
+  doc["rssi"] = sensor.rssi;
+  doc["snr"] = sensor.snr;
+  doc["freqError"] = sensor.frequencyError;
+  doc["receivedAt"] = sensor.receivedAtMs;
+  doc["payload"] = sensor.payload;
+  return serialize(doc, out, size);
+}
+
+}  // namespace BridgeJson
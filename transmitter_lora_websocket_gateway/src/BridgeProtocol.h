@@ -0,0 +1,119 @@
+#pragma once
+#include <Arduino.h>
+
+// Compact binary framing for the gateway <-> server.py WebSocket hop.
+//
+// The link starts in JSON. On connect the gateway sends
+//   {"type":"hello","proto":"bin1","tanks":["tank_001", ...]}
+// and a bridge that understands the format answers
+//   {"type":"proto","proto":"bin1"}
+// after which commands, acks and status travel as binary WebSocket frames
+// laid out below (little-endian, packed). Browsers keep talking JSON to
+// server.py, which translates in both directions. Sensor readings and the
+// diagnostic snapshot stay JSON text. `tank` fields index the hello's
+// "tanks" array, so one gateway can serve several tanks on one socket.
+//
+// A {"type":"dump"} text message asks for the flight recorder; it comes
+// back as Dump messages (binary regardless of the negotiated framing): a
+// DumpHeader followed by `count` FlightRecorder::Record, the last chunk
+// flagged kDumpLast.
+namespace BridgeProtocol {
+
+constexpr char kName[] = "bin1";
+
+enum class MessageType : uint8_t {
+  Command = 0x01,  // bridge  -> gateway
+  Ack = 0x02,      // gateway -> bridge, once the frame is on air
+  Status = 0x03,   // gateway -> bridge, periodic
+  Dump = 0x04      // gateway -> bridge, flight recorder chunk
+};
+
+constexpr uint8_t kHasLeftSpeed = 0x01;   // CommandMessage::flags
+constexpr uint8_t kHasRightSpeed = 0x02;
+constexpr uint8_t kEmergencyStop = 0x04;  // with Command Stop: stop every tank on the gateway
+constexpr uint8_t kAckTransmitted = 0x01; // AckMessage::flags
+constexpr uint8_t kDumpFirst = 0x01;      // DumpHeader::flags
+constexpr uint8_t kDumpLast = 0x02;
+
+#pragma pack(push, 1)
+struct CommandMessage {
+  uint8_t type;        // MessageType::Command
+  uint8_t tank;        // index into the hello's "tanks"
+  uint8_t command;     // TankControl::Command
+  uint8_t flags;       // kHasLeftSpeed / kHasRightSpeed / kEmergencyStop
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  uint16_t sequence;   // bridge-assigned, echoed in the ack
+};
+
+struct AckMessage {
+  uint8_t type;        // MessageType::Ack
+  uint8_t tank;
+  uint8_t command;
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  uint16_t sequence;   // CommandMessage::sequence
+  uint8_t radioSequence;
+  uint8_t flags;       // kAckTransmitted
+  uint32_t gatewayUs;  // WebSocket receive -> LoRa TX done inside the gateway
+};
+
+struct StatusMessage {
+  uint8_t type;        // MessageType::Status
+  uint8_t state;       // last transmitted TankControl::Command
+  uint8_t leftSpeed;
+  uint8_t rightSpeed;
+  int8_t wifiRssi;     // dBm
+  uint8_t channel;     // index into kChannelPlanMHz
+  uint8_t tank;
+  uint8_t reserved;
+  uint32_t uptimeS;
+  uint32_t freeHeap;
+  uint32_t superseded; // this tank's CommandMailbox::superseded()
+};
+
+struct DumpHeader {
+  uint8_t type;        // MessageType::Dump
+  uint8_t flags;       // kDumpFirst / kDumpLast
+  uint16_t count;      // records following this header
+  uint32_t firstIndex; // recorder index of the first record; gaps = overwritten
+  uint64_t nowUs;      // esp_timer when the dump started (same in every chunk)
+};
+#pragma pack(pop)
+
+static_assert(sizeof(CommandMessage) == 8, "CommandMessage must stay 8 bytes");
+static_assert(sizeof(AckMessage) == 13, "AckMessage must stay 13 bytes");
+static_assert(sizeof(StatusMessage) == 20, "StatusMessage must stay 20 bytes");
+static_assert(sizeof(DumpHeader) == 16, "DumpHeader must stay 16 bytes");
+
+template <typename T>
+struct TypeOf;
+template <>
+struct TypeOf<CommandMessage> { static constexpr MessageType value = MessageType::Command; };
+template <>
+struct TypeOf<AckMessage> { static constexpr MessageType value = MessageType::Ack; };
+template <>
+struct TypeOf<StatusMessage> { static constexpr MessageType value = MessageType::Status; };
+template <>
+struct TypeOf<DumpHeader> { static constexpr MessageType value = MessageType::Dump; };
+
+template <typename T>
+bool decode(const uint8_t *data, size_t length, T &out) {
+  if (length != sizeof(T) || data[0] != static_cast<uint8_t>(TypeOf<T>::value)) {
+    return false;
+  }
+  memcpy(&out, data, sizeof(T));
+  return true;
+}
+
+template <typename T>
+size_t encode(T &message, uint8_t *out, size_t capacity) {
+  if (capacity < sizeof(T)) {
+    return 0;
+  }
+  message.type = static_cast<uint8_t>(TypeOf<T>::value);
+  memcpy(out, &message, sizeof(T));
+  return sizeof(T);
+}
+
+}  // namespace BridgeProtocol
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LoRa.h>
+
+namespace ChannelScan {
+
+constexpr size_t kMaxChannels = 8;
+
+struct Result {
+  float frequencyMHz;
+  float averageRssi;  // dBm over the sampling window
+  int peakRssi;       // dBm, loudest single sample
+  uint16_t samples;
+};
+
+struct Report {
+  Result channels[kMaxChannels];
+  size_t count;
+  size_t best;
+  uint32_t durationMs;
+};
+
+// Sample the RSSI register on every channel of the plan for windowMs each
+// and pick the quietest one (lowest average, ties broken by lowest peak).
+// Leaves the radio in receive mode on the chosen channel.
+inline size_t scan(const float *planMHz, size_t planSize, uint32_t windowMs,
+                   Report &report) {
+  report.count = min(planSize, kMaxChannels);
+  report.best = 0;
+  const uint32_t startedAt = millis();
+
+  for (size_t i = 0; i < report.count; ++i) {
+    Result &result = report.channels[i];
+    result.frequencyMHz = planMHz[i];
+    result.peakRssi = -200;
+    result.samples = 0;
+
+    LoRa.idle();
+    LoRa.setFrequency(static_cast<long>(planMHz[i] * 1000000));
+    LoRa.receive();
+    delay(2);  // let the PLL lock and the RSSI estimator settle
+
+    long sum = 0;
+    const uint32_t windowStart = millis();
+    while (millis() - windowStart < windowMs) {
+      int rssi = LoRa.rssi();
+      sum += rssi;
+      result.peakRssi = max(result.peakRssi, rssi);
+      ++result.samples;
+      delayMicroseconds(500);
+    }
+    result.averageRssi = result.samples ? static_cast<float>(sum) / result.samples : 0.0f;
+
+    const Result &best = report.channels[report.best];
+    if (result.averageRssi < best.averageRssi ||
+        (result.averageRssi == best.averageRssi && result.peakRssi < best.peakRssi)) {
+      report.best = i;
+    }
+  }
+
+  report.durationMs = millis() - startedAt;
+  LoRa.idle();
+  LoRa.setFrequency(static_cast<long>(report.channels[report.best].frequencyMHz * 1000000));
+  LoRa.receive();
+  return report.best;
+}
+
+inline void print(Print &out, const Report &report) {
+  out.printf("[SCAN] %u channels in %lu ms\n", static_cast<unsigned>(report.count),
+             static_cast<unsigned long>(report.durationMs));
+  for (size_t i = 0; i < report.count; ++i) {
+    const Result &r = report.channels[i];
+    out.printf("[SCAN] %c ch%u %.1f MHz avg=%.1f dBm peak=%d dBm (%u samples)\n",
+               i == report.best ? '*' : ' ', static_cast<unsigned>(i),
+               r.frequencyMHz, r.averageRssi, r.peakRssi, r.samples);
+  }
+}
+
+}  // namespace ChannelScan
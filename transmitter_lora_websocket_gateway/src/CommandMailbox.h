@@ -0,0 +1,117 @@
+#pragma once
+#include <Arduino.h>
+
+// Latest-wins hand-off between the command task and the radio task.
+//
+// The radio can only put one control frame on air per airtime, so queueing
+// every slider tick just makes the tank replay stale setpoints. The mailbox
+// holds at most one pending Stop and one pending setpoint:
+//   - a new setpoint overwrites the pending one (counted as superseded);
+//   - a Stop discards the pending setpoint and is never itself dropped;
+//   - take() always returns a pending Stop before the setpoint, and any
+//     setpoint still pending at that point arrived after the Stop.
+// So the radio never sends anything older than the last Stop, and at most
+// one frame is waiting behind the one currently on air.
+template <typename T>
+class CommandMailbox {
+public:
+  // Producer side. isStop marks entries that must not be coalesced away.
+  void post(const T &item, bool isStop) {
+    portENTER_CRITICAL(&lock_);
+    ++posted_;
+    if (isStop) {
+      if (hasSetpoint_) {
+        hasSetpoint_ = false;
+        ++superseded_;
+      }
+      if (hasStop_) {
+        ++superseded_;  // back-to-back Stops collapse into one
+      }
+      stop_ = item;
+      hasStop_ = true;
+      ++stops_;
+    } else {
+      if (hasSetpoint_) {
+        ++superseded_;
+      }
+      setpoint_ = item;
+      hasSetpoint_ = true;
+    }
+    portEXIT_CRITICAL(&lock_);
+  }
+
+  // Consumer side. Returns false when nothing is pending.
+  bool take(T &item) {
+    bool found = true;
+    portENTER_CRITICAL(&lock_);
+    if (hasStop_) {
+      item = stop_;
+      hasStop_ = false;
+    } else if (hasSetpoint_) {
+      item = setpoint_;
+      hasSetpoint_ = false;
+    } else {
+      found = false;
+    }
+    portEXIT_CRITICAL(&lock_);
+    return found;
+  }
+
+  // Consumer side: only a pending Stop, so a scheduler can serve Stops for
+  // every mailbox before any setpoint.
+  bool takeStop(T &item) {
+    bool found = false;
+    portENTER_CRITICAL(&lock_);
+    if (hasStop_) {
+      item = stop_;
+      hasStop_ = false;
+      found = true;
+    }
+    portEXIT_CRITICAL(&lock_);
+    return found;
+  }
+
+  // Consumer side: hand back a setpoint that was taken but preempted before
+  // it went on air. Dropped if a Stop or a newer setpoint arrived since.
+  bool putBack(const T &item) {
+    bool restored = false;
+    portENTER_CRITICAL(&lock_);
+    if (!hasStop_ && !hasSetpoint_) {
+      setpoint_ = item;
+      hasSetpoint_ = true;
+      restored = true;
+    }
+    portEXIT_CRITICAL(&lock_);
+    return restored;
+  }
+
+  // Consumer side: hand back a Stop that failed to go on air, so it is sent
+  // again. Dropped if a newer Stop or setpoint arrived since.
+  bool putBackStop(const T &item) {
+    bool restored = false;
+    portENTER_CRITICAL(&lock_);
+    if (!hasStop_ && !hasSetpoint_) {
+      stop_ = item;
+      hasStop_ = true;
+      restored = true;
+    }
+    portEXIT_CRITICAL(&lock_);
+    return restored;
+  }
+
+  bool pending() const { return hasStop_ || hasSetpoint_; }
+  bool stopPending() const { return hasStop_; }
+  uint32_t posted() const { return posted_; }
+  uint32_t superseded() const { return superseded_; }
+  uint32_t stops() const { return stops_; }
+
+private:
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+  T stop_{};
+  T setpoint_{};
+  volatile bool hasStop_ = false;
+  volatile bool hasSetpoint_ = false;
+  uint32_t posted_ = 0;
+  uint32_t superseded_ = 0;
+  uint32_t stops_ = 0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <Arduino.h>
+#include <esp_timer.h>
+
+// Flight recorder: the last N gateway events (commands, TX results, link
+// and status changes) as fixed 16-byte records in a ring, preferably in
+// PSRAM. Recording is a critical section around a 16-byte copy: no heap,
+// no formatting, safe from any task. The ring is only read back when an
+// operator asks for a dump (BridgeProtocol::DumpHeader chunks), and
+// flight_decode.py on the host turns that into CSV.
+//
+// Timestamps are the low 32 bits of esp_timer (us, wraps every ~71 min);
+// records are in time order, so the decoder unwraps them against the dump
+// header's 64-bit time.
+class FlightRecorder {
+public:
+  enum class Kind : uint8_t {
+    Command = 1,     // queued for the radio: arg radio seq, aux host seq, value left | right << 8
+    TxDone = 2,      // on air: arg radio seq, aux host seq, value gateway us
+    TxFailed = 3,    // arg radio seq, aux host seq
+    Preempted = 4,   // setpoint skipped for a Stop: arg radio seq, aux host seq
+    Status = 5,      // arg WiFi RSSI (int8), value free heap
+    LinkUp = 6,      // value connect ms
+    LinkDown = 7,    // WebSocket or WiFi lost
+    LinkDead = 8,    // missed pongs: value detection ms
+    EStop = 9        // emergency stop, all tanks
+  };
+
+#pragma pack(push, 1)
+  struct Record {
+    uint32_t timeUs;   // esp_timer, low 32 bits
+    uint8_t kind;      // Kind
+    uint8_t tank;      // index into TANK_TABLE, 0xFF if not tank-specific
+    uint8_t command;   // TankControl::Command
+    uint8_t arg;
+    uint16_t aux;
+    uint16_t reserved;
+    uint32_t value;
+  };
+#pragma pack(pop)
+  static_assert(sizeof(Record) == 16, "FlightRecorder::Record is a 16-byte wire format");
+
+  static constexpr uint8_t kNoTank = 0xFF;
+
+  // Allocates the ring: `records` entries in PSRAM, or fallbackRecords in
+  // internal RAM on boards without it. Returns the capacity (0 = disabled).
+  size_t begin(size_t records, size_t fallbackRecords) {
+    if (psramFound()) {
+      ring_ = static_cast<Record *>(ps_malloc(records * sizeof(Record)));
+      capacity_ = ring_ ? records : 0;
+      inPsram_ = ring_ != nullptr;
+    }
+    if (!ring_) {
+      ring_ = static_cast<Record *>(malloc(fallbackRecords * sizeof(Record)));
+      capacity_ = ring_ ? fallbackRecords : 0;
+    }
+    return capacity_;
+  }
+
+  // Any task.
+  void record(Kind kind, uint8_t tank, uint8_t command = 0, uint8_t arg = 0, uint16_t aux = 0,
+              uint32_t value = 0) {
+    if (!capacity_) {
+      return;
+    }
+    portENTER_CRITICAL(&lock_);
+    Record &r = ring_[head_ % capacity_];
+    r.timeUs = static_cast<uint32_t>(esp_timer_get_time());
+    r.kind = static_cast<uint8_t>(kind);
+    r.tank = tank;
+    r.command = command;
+    r.arg = arg;
+    r.aux = aux;
+    r.reserved = 0;
+    r.value = value;
+    ++head_;
+    portEXIT_CRITICAL(&lock_);
+  }
+
+  // Index one past the newest record; indices only grow.
+  uint32_t head() const { return head_; }
+  // Oldest index still held.
+  uint32_t tail() const { return head_ > capacity_ ? head_ - capacity_ : 0; }
+
+  // Copies up to max records starting at *index (advanced past the copy).
+  // If the writer has lapped *index, copying starts at the oldest record
+  // still held and *index reflects that. Returns the number copied.
+  size_t copy(uint32_t *index, uint32_t end, Record *out, size_t max) {
+    portENTER_CRITICAL(&lock_);
+    if (*index < tail()) {
+      *index = tail();
+    }
+    size_t n = 0;
+    while (n < max && *index + n < end) {
+      out[n] = ring_[(*index + n) % capacity_];
+      ++n;
+    }
+    portEXIT_CRITICAL(&lock_);
+    *index += n;
+    return n;
+  }
+
+  size_t capacity() const { return capacity_; }
+  bool inPsram() const { return inPsram_; }
+
+private:
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+  Record *ring_ = nullptr;
+  size_t capacity_ = 0;
+  bool inPsram_ = false;
+  volatile uint32_t head_ = 0;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Fixed bump allocator for ArduinoJson 7 documents. ArduinoJson 7 puts every
+// JsonDocument on the heap; handing it an arena instead keeps the command
+// and telemetry path allocation-free. One arena per task, reset() before
+// building each document; only one document may live in an arena at a time.
+template <size_t N>
+class JsonArena : public ArduinoJson::Allocator {
+public:
+  void reset() {
+    used_ = 0;
+    last_ = nullptr;
+  }
+
+  void *allocate(size_t size) override {
+    const size_t block = align(size) + kHeader;
+    if (used_ + block > N) {
+      ++overflows_;
+      return nullptr;
+    }
+    uint8_t *base = buffer_ + used_;
+    writeSize(base, size);
+    used_ += block;
+    if (used_ > peak_) {
+      peak_ = used_;
+    }
+    last_ = base + kHeader;
+    return last_;
+  }
+
+  // Blocks are released wholesale by reset().
+  void deallocate(void *) override {}
+
+  // ArduinoJson grows and then shrinks its pools; the most recent block is
+  // resized in place, anything else is moved.
+  void *reallocate(void *ptr, size_t newSize) override {
+    if (!ptr) {
+      return allocate(newSize);
+    }
+    uint8_t *header = static_cast<uint8_t *>(ptr) - kHeader;
+    if (ptr == last_) {
+      const size_t start = header - buffer_;
+      const size_t block = align(newSize) + kHeader;
+      if (start + block > N) {
+        ++overflows_;
+        return nullptr;
+      }
+      writeSize(header, newSize);
+      used_ = start + block;
+      if (used_ > peak_) {
+        peak_ = used_;
+      }
+      return ptr;
+    }
+    const size_t oldSize = readSize(header);
+    void *moved = allocate(newSize);
+    if (moved) {
+      memcpy(moved, ptr, min(oldSize, newSize));
+    }
+    return moved;
+  }
+
+  size_t peak() const { return peak_; }
+  uint32_t overflows() const { return overflows_; }
+  static constexpr size_t capacity() { return N; }
+
+private:
+  static constexpr size_t kAlign = alignof(max_align_t) < 8 ? alignof(max_align_t) : 8;
+  static constexpr size_t kHeader = kAlign;
+
+  static size_t align(size_t size) { return (size + kAlign - 1) & ~(kAlign - 1); }
+  static void writeSize(uint8_t *header, size_t size) { memcpy(header, &size, sizeof(size)); }
+  static size_t readSize(const uint8_t *header) {
+    size_t size;
+    memcpy(&size, header, sizeof(size));
+    return size;
+  }
+
+  alignas(8) uint8_t buffer_[N];
+  size_t used_ = 0;
+  size_t peak_ = 0;
+  uint32_t overflows_ = 0;
+  void *last_ = nullptr;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <Arduino.h>
+
+// Fixed log2-bucket latency histogram: bucket 0 holds samples below
+// kFirstBucketUs, bucket i holds [kFirstBucketUs << (i-1), kFirstBucketUs << i),
+// and the last bucket collects everything above ~1 s. Percentiles are
+// reported as the upper bound of the bucket they fall in, which is plenty to
+// tell a 200 us JSON parse from a 50 ms airtime. Single writer.
+class LatencyHistogram {
+public:
+  static constexpr size_t kBuckets = 16;
+  static constexpr uint32_t kFirstBucketUs = 64;
+
+  void record(uint32_t us) {
+    ++buckets_[bucketFor(us)];
+    ++count_;
+    if (us > max_) {
+      max_ = us;
+    }
+  }
+
+  // p in [0, 100]. Returns 0 when empty.
+  uint32_t percentileUs(uint8_t p) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    const uint32_t rank = (static_cast<uint64_t>(count_) * p + 99) / 100;
+    uint32_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank && seen > 0) {
+        return i + 1 < kBuckets ? upperBoundUs(i) : max_;
+      }
+    }
+    return max_;
+  }
+
+  uint32_t count() const { return count_; }
+  uint32_t maxUs() const { return max_; }
+  uint32_t bucket(size_t i) const { return buckets_[i]; }
+  static uint32_t upperBoundUs(size_t i) { return kFirstBucketUs << i; }
+
+private:
+  static size_t bucketFor(uint32_t us) {
+    if (us < kFirstBucketUs) {
+      return 0;
+    }
+    const size_t i = 32 - __builtin_clz(us / kFirstBucketUs);
+    return i < kBuckets ? i : kBuckets - 1;
+  }
+
+  uint32_t buckets_[kBuckets] = {};
+  uint32_t count_ = 0;
+  uint32_t max_ = 0;
+};
@@ -0,0 +1,168 @@
+#include "RadioScheduler.h"
+#include <LoRa.h>
+#include <esp_timer.h>
+
+namespace {
+// SX127x RegModemStat: set while a packet is being demodulated.
+constexpr uint8_t kRegModemStat = 0x18;
+constexpr uint8_t kModemSignalSynchronized = 0x02;
+constexpr uint8_t kIrqTxDone = 0x08;
+// Longest control frame (wake preamble) is ~300 ms; this only guards
+// against a modem that never raises TxDone.
+constexpr uint32_t kTxDoneTimeoutMs = 2000;
+
+uint64_t nowUs() { return static_cast<uint64_t>(esp_timer_get_time()); }
+}  // namespace
+
+void RadioScheduler::begin(const RadioProfile &control, const RadioProfile *sensor,
+                           uint8_t csPin) {
+  control_ = control;
+  hasSensor_ = sensor != nullptr;
+  if (hasSensor_) {
+    sensor_ = *sensor;
+  }
+  csPin_ = csPin;
+
+  startedUs_ = nowUs();
+  slotSinceUs_ = startedUs_;
+  slot_ = Slot::Control;
+  apply_(control_);
+  if (hasSensor_) {
+    enter_(Slot::Sensor);
+  }
+  LoRa.receive();
+}
+
+void RadioScheduler::setControlFrequency(float frequencyMHz) {
+  control_.frequencyMHz = frequencyMHz;
+  if (slot_ == Slot::Control) {
+    LoRa.idle();
+    LoRa.setFrequency(static_cast<long>(frequencyMHz * 1000000));
+    LoRa.receive();
+  }
+}
+
+bool RadioScheduler::transmitControl(const uint8_t *buffer, size_t length,
+                                     long preambleSymbols, bool implicitHeader) {
+  if (slot_ == Slot::Sensor &&
+      (LoRaRx::readRegister(csPin_, kRegModemStat) & kModemSignalSynchronized)) {
+    ++sensorPreemptions_;  // a sensor packet was mid-air; control wins
+  }
+  enter_(Slot::Control);
+
+  LoRa.idle();
+  if (preambleSymbols != control_.preambleSymbols) {
+    LoRa.setPreambleLength(preambleSymbols);
+  }
+  LoRa.beginPacket(implicitHeader);
+  LoRa.write(buffer, length);
+  bool ok = LoRa.endPacket(true) == 1 && waitTxDone_();
+  if (preambleSymbols != control_.preambleSymbols) {
+    LoRa.setPreambleLength(control_.preambleSymbols);
+  }
+  if (ok) {
+    ++stats_[static_cast<uint8_t>(Slot::Control)].packets;
+  }
+
+  if (hasSensor_) {
+    enter_(Slot::Sensor);
+  }
+  LoRa.receive();
+  return ok;
+}
+
+LoRaRx::Packet *RadioScheduler::pollSensor() {
+  if (!hasSensor_ || slot_ != Slot::Sensor) {
+    return nullptr;
+  }
+  int packetSize = LoRa.parsePacket();
+  if (packetSize <= 0) {
+    return nullptr;
+  }
+  LoRaRx::Packet *packet = pool_.acquire();
+  if (!packet) {
+    return nullptr;
+  }
+  LoRaRx::readPacket(packetSize, csPin_, *packet);
+  ++stats_[static_cast<uint8_t>(Slot::Sensor)].packets;
+  return packet;
+}
+
+float RadioScheduler::utilisation(Slot slot) const {
+  uint64_t now = nowUs();
+  uint64_t active = stats_[static_cast<uint8_t>(slot)].activeUs;
+  if (slot == slot_) {
+    active += now - slotSinceUs_;
+  }
+  uint64_t total = now - startedUs_;
+  return total == 0 ? 0.0f : 100.0f * static_cast<float>(active) / static_cast<float>(total);
+}
+
+uint32_t RadioScheduler::avgSwitchUs() const {
+  return switchCount_ == 0 ? 0 : static_cast<uint32_t>(switchTotalUs_ / switchCount_);
+}
+
+void RadioScheduler::printStats(Print &out) const {
+  out.printf("[RADIO] control %.1f%% (%lu tx) sensor %.1f%% (%lu rx, %lu preempted) "
+             "switch avg=%luus max=%luus\n",
+             utilisation(Slot::Control),
+             static_cast<unsigned long>(stats(Slot::Control).packets),
+             utilisation(Slot::Sensor),
+             static_cast<unsigned long>(stats(Slot::Sensor).packets),
+             static_cast<unsigned long>(sensorPreemptions_),
+             static_cast<unsigned long>(avgSwitchUs()),
+             static_cast<unsigned long>(maxSwitchUs_));
+}
+
+// LoRa.endPacket() spins on yield() for the whole airtime, which keeps the
+// lower-priority command task on this core from parsing a Stop meanwhile.
+// Sleeping a tick between TxDone polls hands it the core instead.
+bool RadioScheduler::waitTxDone_() {
+  const uint64_t start = nowUs();
+  bool done = true;
+  while ((LoRaRx::readRegister(csPin_, LoRaRx::kRegIrqFlags) & kIrqTxDone) == 0) {
+    if (nowUs() - start >= kTxDoneTimeoutMs * 1000ULL) {
+      LoRa.idle();
+      done = false;
+      break;
+    }
+    vTaskDelay(1);
+  }
+  LoRaRx::writeRegister(csPin_, LoRaRx::kRegIrqFlags, kIrqTxDone);
+  txWaitUs_ += nowUs() - start;
+  return done;
+}
+
+void RadioScheduler::enter_(Slot slot) {
+  if (slot == slot_) {
+    return;
+  }
+  account_();
+  uint64_t start = nowUs();
+  apply_(slot == Slot::Control ? control_ : sensor_);
+  uint32_t elapsed = static_cast<uint32_t>(nowUs() - start);
+
+  slot_ = slot;
+  ++stats_[static_cast<uint8_t>(slot)].switches;
+  switchTotalUs_ += elapsed;
+  ++switchCount_;
+  if (elapsed > maxSwitchUs_) {
+    maxSwitchUs_ = elapsed;
+  }
+}
+
+void RadioScheduler::apply_(const RadioProfile &profile) {
+  LoRa.idle();
+  LoRa.setFrequency(static_cast<long>(profile.frequencyMHz * 1000000));
+  LoRa.setSpreadingFactor(profile.spreadingFactor);
+  LoRa.setSignalBandwidth(profile.bandwidthHz);
+  LoRa.setCodingRate4(profile.codingRateDenominator);
+  LoRa.setSyncWord(profile.syncWord);
+  LoRa.setPreambleLength(profile.preambleSymbols);
+}
+
+void RadioScheduler::account_() {
+  uint64_t now = nowUs();
+  stats_[static_cast<uint8_t>(slot_)].activeUs += now - slotSinceUs_;
+  slotSinceUs_ = now;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <Arduino.h>
+#include "LoRaRx.h"
+
+// Modem settings for one logical link sharing the SX127x.
+struct RadioProfile {
+  float frequencyMHz;
+  uint8_t spreadingFactor;
+  uint32_t bandwidthHz;
+  uint8_t codingRateDenominator;
+  uint8_t syncWord;
+  long preambleSymbols;
+};
+
+// Time-slices one SX127x between the control TX link and the sensor RX
+// link. The radio parks in the sensor profile listening; a control frame
+// always preempts it (even mid-packet), is sent on the control profile and
+// the radio returns to sensor RX right after TX-done. Without a sensor
+// profile the radio simply stays on the control profile.
+class RadioScheduler {
+public:
+  enum class Slot : uint8_t { Control = 0, Sensor = 1 };
+
+  struct SlotStats {
+    uint64_t activeUs = 0;   // time the radio spent configured for this slot
+    uint32_t switches = 0;   // reconfigurations into this slot
+    uint32_t packets = 0;    // frames sent (control) or received (sensor)
+  };
+
+  void begin(const RadioProfile &control, const RadioProfile *sensor, uint8_t csPin);
+
+  // Retune the control profile (channel selection) without leaving the slot.
+  void setControlFrequency(float frequencyMHz);
+  bool sharesRadio() const { return hasSensor_; }
+
+  // Send one control packet; the calling task sleeps until TX-done.
+  bool transmitControl(const uint8_t *buffer, size_t length, long preambleSymbols,
+                       bool implicitHeader);
+
+  // Poll the sensor slot; returns a pooled packet the caller must release.
+  LoRaRx::Packet *pollSensor();
+  void releasePacket(LoRaRx::Packet *packet) { pool_.release(packet); }
+
+  const SlotStats &stats(Slot slot) const { return stats_[static_cast<uint8_t>(slot)]; }
+  float utilisation(Slot slot) const;     // percent of uptime since begin()
+  uint32_t maxSwitchUs() const { return maxSwitchUs_; }
+  uint32_t avgSwitchUs() const;
+  uint32_t sensorPreemptions() const { return sensorPreemptions_; }
+  uint64_t txWaitUs() const { return txWaitUs_; }  // slept waiting for TX-done
+  void printStats(Print &out) const;
+
+private:
+  bool waitTxDone_();
+  void enter_(Slot slot);
+  void apply_(const RadioProfile &profile);
+  void account_();
+
+  RadioProfile control_{};
+  RadioProfile sensor_{};
+  bool hasSensor_ = false;
+  uint8_t csPin_ = 0;
+
+  Slot slot_ = Slot::Control;
+  uint64_t slotSinceUs_ = 0;
+  uint64_t startedUs_ = 0;
+  uint64_t switchTotalUs_ = 0;
+  uint32_t switchCount_ = 0;
+  uint32_t maxSwitchUs_ = 0;
+  uint32_t sensorPreemptions_ = 0;
+  uint64_t txWaitUs_ = 0;
+  SlotStats stats_[2];
+
+  LoRaRx::PacketPool<2> pool_;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+// Fixed-capacity single-producer / single-consumer ring. Slots live inside
+// the object, so nothing is allocated after construction. Large messages use
+// the claim()/commit() and front()/release() pairs to fill and drain a slot
+// in place instead of copying it.
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+  // ----- producer side -----
+  T *claim() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= N) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &slots_[head & (N - 1)];
+  }
+
+  void commit() {
+    const size_t head = head_.load(std::memory_order_relaxed) + 1;
+    head_.store(head, std::memory_order_release);
+    const size_t depth = head - tail_.load(std::memory_order_acquire);
+    if (depth > highWater_.load(std::memory_order_relaxed)) {
+      highWater_.store(depth, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(const T &item) {
+    T *slot = claim();
+    if (!slot) {
+      return false;
+    }
+    *slot = item;
+    commit();
+    return true;
+  }
+
+  // ----- consumer side -----
+  T *front() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[tail & (N - 1)];
+  }
+
+  void release() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  bool pop(T &item) {
+    T *slot = front();
+    if (!slot) {
+      return false;
+    }
+    item = *slot;
+    release();
+    return true;
+  }
+
+  // ----- metrics (any task) -----
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  size_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  static constexpr size_t capacity() { return N; }
+
+private:
+  T slots_[N];
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<size_t> highWater_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
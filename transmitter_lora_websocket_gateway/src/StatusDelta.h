@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+
+// Change detector behind the gateway's delta status stream. Each field is
+// reported again only once it has moved by at least `threshold` since the
+// last value sent and `minIntervalMs` has passed since that send, so a
+// drifting RSSI or heap figure cannot flood the bridge. A full snapshot
+// calls commitAll() to make every field current.
+struct DeltaField {
+  const char *name;
+  float threshold;        // 0 = any change
+  uint32_t minIntervalMs;
+};
+
+template <size_t N>
+class StatusDelta {
+public:
+  explicit StatusDelta(const DeltaField (&fields)[N]) : fields_(fields) {}
+
+  // Record the current value of a field; returns true when it is due.
+  bool update(size_t index, float value, uint32_t now) {
+    Slot &slot = slots_[index];
+    slot.current = value;
+    const DeltaField &field = fields_[index];
+    const float moved = value > slot.sent ? value - slot.sent : slot.sent - value;
+    slot.due = !slot.valid ||
+               ((field.threshold == 0 ? moved != 0 : moved >= field.threshold) &&
+                now - slot.sentAt >= field.minIntervalMs);
+    return slot.due;
+  }
+
+  bool due(size_t index) const { return slots_[index].due; }
+  const char *name(size_t index) const { return fields_[index].name; }
+
+  void commit(size_t index, uint32_t now) {
+    Slot &slot = slots_[index];
+    slot.sent = slot.current;
+    slot.sentAt = now;
+    slot.valid = true;
+    slot.due = false;
+  }
+
+  void commitAll(uint32_t now) {
+    for (size_t i = 0; i < N; ++i) {
+      commit(i, now);
+    }
+  }
+
+  // Forget what was sent, e.g. after the bridge reconnects.
+  void invalidate() {
+    for (size_t i = 0; i < N; ++i) {
+      slots_[i].valid = false;
+    }
+  }
+
+  static constexpr size_t size() { return N; }
+
+private:
+  struct Slot {
+    float current = 0;
+    float sent = 0;
+    uint32_t sentAt = 0;
+    bool valid = false;
+    bool due = false;
+  };
+
+  const DeltaField (&fields_)[N];
+  Slot slots_[N];
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include "ControlProtocol.h"
+
+// What a tank's heartbeats repeat, and whether it is still owed a Stop.
+//
+// A Stop ends the heartbeats when it is queued, not when it is on air: if
+// its transmission fails the gateway must not keep refreshing the receiver's
+// watchdog with the motion the Stop was meant to end. Until some Stop has
+// gone on air the tank is owed one, and a failed Stop is retried
+// (stopRetryDue) unless a newer command has replaced it.
+//
+// queued() hands out a generation that travels with the request; a result
+// from an older generation (a frame that was taken for the radio before a
+// newer command was queued) no longer changes anything. Heartbeats go out
+// under the current generation. Single writer: the command task.
+class TankMotion {
+public:
+  // A bridge or safety command (not a heartbeat) was posted to the mailbox.
+  uint32_t queued(TankControl::Command command) {
+    ++generation_;
+    stopRetry_ = false;
+    stopOwed_ = command == TankControl::Command::Stop;
+    if (stopOwed_) {
+      motion_ = TankControl::Command::Stop;
+      left_ = right_ = 0;
+    }
+    return generation_;
+  }
+
+  // ok: the frame went on air (false for failed and preempted ones).
+  void result(uint32_t generation, TankControl::Command command, uint8_t left, uint8_t right,
+              bool ok) {
+    if (generation != generation_) {
+      return;
+    }
+    if (command == TankControl::Command::Stop) {
+      stopOwed_ = !ok;
+      stopRetry_ = !ok;
+      return;
+    }
+    if (!ok) {
+      return;
+    }
+    // SetSpeed changes the speeds but keeps the receiver's direction.
+    if (TankControl::isMotion(command)) {
+      motion_ = command;
+    }
+    left_ = left;
+    right_ = right;
+  }
+
+  // A Stop failed and nothing newer was queued: post it again. queued()
+  // for the retry clears this until its own result comes back.
+  bool stopRetryDue() const { return stopRetry_; }
+  bool heartbeatDue() const { return TankControl::isMotion(motion_) && !stopOwed_; }
+
+  uint32_t generation() const { return generation_; }
+  TankControl::Command motion() const { return motion_; }
+  uint8_t left() const { return left_; }
+  uint8_t right() const { return right_; }
+
+private:
+  TankControl::Command motion_ = TankControl::Command::Stop;
+  uint8_t left_ = 0;
+  uint8_t right_ = 0;
+  uint32_t generation_ = 0;
+  bool stopOwed_ = false;
+  bool stopRetry_ = false;
+};
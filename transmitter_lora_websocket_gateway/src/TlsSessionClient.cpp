@@ -0,0 +1,325 @@
+#include "TlsSessionClient.h"
+#include "AsyncLog.h"
+#include <mbedtls/sha256.h>
+#include <lwip/sockets.h>
+#include <strings.h>
+
+namespace {
+constexpr char kPersonalisation[] = "tank-gateway-tls";
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// 64 hex digits, optionally separated by ':' or ' ', after an optional
+// "SHA256 Fingerprint=" (openssl x509 -fingerprint output, either case).
+bool parseFingerprint(const char *text, uint8_t (&out)[32]) {
+  static constexpr char kOpensslPrefix[] = "sha256 fingerprint=";
+  if (strncasecmp(text, kOpensslPrefix, sizeof(kOpensslPrefix) - 1) == 0) {
+    text += sizeof(kOpensslPrefix) - 1;
+  }
+  size_t nibbles = 0;
+  for (const char *p = text; *p; ++p) {
+    if (*p == ':' || *p == ' ') {
+      continue;
+    }
+    const int value = hexValue(*p);
+    if (value < 0 || nibbles >= 64) {
+      return false;
+    }
+    out[nibbles / 2] = static_cast<uint8_t>((out[nibbles / 2] << 4) | value);
+    ++nibbles;
+  }
+  return nibbles == 64;
+}
+
+bool retryable(int ret) {
+  return ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
+         ret == MBEDTLS_ERR_SSL_TIMEOUT;
+}
+}  // namespace
+
+TlsSessionClient::TlsSessionClient(const char *caPem, const char *fingerprint,
+                                   const char *serverName)
+    : caPem_(caPem), serverName_(serverName) {
+  if (fingerprint) {
+    pinFingerprint_ = true;
+    fingerprintValid_ = parseFingerprint(fingerprint, fingerprint_);
+  }
+  mbedtls_net_init(&net_);
+  mbedtls_ssl_init(&ssl_);
+  mbedtls_ssl_config_init(&conf_);
+  mbedtls_ssl_session_init(&session_);
+  mbedtls_entropy_init(&entropy_);
+  mbedtls_ctr_drbg_init(&drbg_);
+  mbedtls_x509_crt_init(&ca_);
+}
+
+TlsSessionClient::~TlsSessionClient() {
+  close();
+  mbedtls_x509_crt_free(&ca_);
+  mbedtls_ctr_drbg_free(&drbg_);
+  mbedtls_entropy_free(&entropy_);
+  mbedtls_ssl_session_free(&session_);
+  mbedtls_ssl_config_free(&conf_);
+  mbedtls_ssl_free(&ssl_);
+}
+
+// Deferred to the first connect so nothing runs before the RNG and WiFi
+// are up.
+bool TlsSessionClient::init_() {
+  if (initialised_) {
+    return true;
+  }
+  // A pin that was configured but cannot be used fails closed: falling back
+  // to VERIFY_NONE would hide the mistake behind a working link.
+  if (pinFingerprint_ && !fingerprintValid_) {
+    LOG_E("[TLS] Fingerprint does not parse; refusing to connect");
+    fail_(MBEDTLS_ERR_X509_BAD_INPUT_DATA);
+    return false;
+  }
+  int ret = mbedtls_ctr_drbg_seed(&drbg_, mbedtls_entropy_func, &entropy_,
+                                  reinterpret_cast<const unsigned char *>(kPersonalisation),
+                                  sizeof(kPersonalisation) - 1);
+  if (ret == 0) {
+    ret = mbedtls_ssl_config_defaults(&conf_, MBEDTLS_SSL_IS_CLIENT,
+                                      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+  }
+  if (ret != 0) {
+    fail_(ret);
+    return false;
+  }
+
+  if (caPem_) {
+    ret = mbedtls_x509_crt_parse(&ca_, reinterpret_cast<const unsigned char *>(caPem_),
+                                 strlen(caPem_) + 1);
+    if (ret != 0) {
+      LOG_E("[TLS] CA certificate does not parse (-0x%04x)", -ret);
+      fail_(ret);
+      return false;
+    }
+    mbedtls_ssl_conf_ca_chain(&conf_, &ca_, nullptr);
+    mbedtls_ssl_conf_authmode(&conf_, MBEDTLS_SSL_VERIFY_REQUIRED);
+  } else if (pinFingerprint_) {
+    // The chain may be self-signed; the fingerprint check decides.
+    mbedtls_ssl_conf_authmode(&conf_, MBEDTLS_SSL_VERIFY_OPTIONAL);
+  } else {
+    LOG_W("[TLS] No CA or fingerprint pinned; the bridge is not authenticated");
+    mbedtls_ssl_conf_authmode(&conf_, MBEDTLS_SSL_VERIFY_NONE);
+  }
+  mbedtls_ssl_conf_rng(&conf_, mbedtls_ctr_drbg_random, &drbg_);
+  mbedtls_ssl_conf_read_timeout(&conf_, kReadTimeoutMs);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  mbedtls_ssl_conf_session_tickets(&conf_, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+  ret = mbedtls_ssl_setup(&ssl_, &conf_);
+  if (ret == 0) {
+    ret = mbedtls_ssl_set_hostname(&ssl_, serverName_);
+  }
+  if (ret != 0) {
+    fail_(ret);
+    return false;
+  }
+  initialised_ = true;
+  return true;
+}
+
+bool TlsSessionClient::connect(const websockets::WSString &host, const int port) {
+  close();
+  if (!init_()) {
+    return false;
+  }
+
+  char portText[8];
+  snprintf(portText, sizeof(portText), "%d", port);
+  const uint32_t tcpStart = millis();
+  int ret = mbedtls_net_connect(&net_, host.c_str(), portText, MBEDTLS_NET_PROTO_TCP);
+  if (ret != 0) {
+    fail_(ret);
+    return false;
+  }
+  stats_.lastTcpMs = millis() - tcpStart;
+  const int noDelay = 1;
+  setsockopt(net_.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+  mbedtls_ssl_session_reset(&ssl_);
+  mbedtls_ssl_set_bio(&ssl_, &net_, mbedtls_net_send, nullptr, mbedtls_net_recv_timeout);
+  if (haveSession_) {
+    mbedtls_ssl_set_session(&ssl_, &session_);
+  }
+
+  const uint32_t handshakeStart = millis();
+  bool resumed = false;
+  if (!handshake_(resumed)) {
+    // A stale or rejected session must not poison the next attempt.
+    forgetSession();
+    mbedtls_net_free(&net_);
+    return false;
+  }
+  const uint32_t handshakeMs = millis() - handshakeStart;
+
+  if (!resumed && pinFingerprint_ && !verifyFingerprint_()) {
+    LOG_E("[TLS] Bridge certificate fingerprint mismatch");
+    fail_(MBEDTLS_ERR_X509_CERT_VERIFY_FAILED);
+    forgetSession();
+    mbedtls_ssl_close_notify(&ssl_);
+    mbedtls_net_free(&net_);
+    return false;
+  }
+
+  mbedtls_ssl_session_free(&session_);
+  mbedtls_ssl_session_init(&session_);
+  haveSession_ = mbedtls_ssl_get_session(&ssl_, &session_) == 0;
+
+  ++stats_.handshakes;
+  stats_.lastHandshakeMs = handshakeMs;
+  stats_.lastResumed = resumed;
+  stats_.lastError = 0;
+  if (resumed) {
+    ++stats_.resumed;
+    stats_.totalResumedMs += handshakeMs;
+  } else {
+    stats_.totalFullMs += handshakeMs;
+  }
+  connected_ = true;
+  LOG_I("[TLS] %s handshake in %lu ms (TCP %lu ms), %s", resumed ? "Resumed" : "Full",
+        static_cast<unsigned long>(handshakeMs), static_cast<unsigned long>(stats_.lastTcpMs),
+        mbedtls_ssl_get_ciphersuite(&ssl_));
+  return true;
+}
+
+// Stepped so a resumption can be told apart from a full handshake: only a
+// full one reaches the server Certificate state.
+bool TlsSessionClient::handshake_(bool &resumed) {
+  const uint32_t start = millis();
+  bool sawCertificate = false;
+  while (ssl_.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+    if (ssl_.state == MBEDTLS_SSL_SERVER_CERTIFICATE) {
+      sawCertificate = true;
+    }
+    const int ret = mbedtls_ssl_handshake_step(&ssl_);
+    if (ret != 0 && !retryable(ret)) {
+      fail_(ret);
+      if (ret == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED) {
+        LOG_E("[TLS] Certificate verification failed (flags 0x%08lx)",
+              static_cast<unsigned long>(mbedtls_ssl_get_verify_result(&ssl_)));
+      }
+      return false;
+    }
+    if (millis() - start > kHandshakeTimeoutMs) {
+      fail_(MBEDTLS_ERR_SSL_TIMEOUT);
+      return false;
+    }
+  }
+  resumed = haveSession_ && !sawCertificate;
+  return true;
+}
+
+bool TlsSessionClient::verifyFingerprint_() {
+  const mbedtls_x509_crt *peer = mbedtls_ssl_get_peer_cert(&ssl_);
+  if (!peer) {
+    return false;
+  }
+  uint8_t digest[32];
+  mbedtls_sha256_ret(peer->raw.p, peer->raw.len, digest, 0);
+  return memcmp(digest, fingerprint_, sizeof(digest)) == 0;
+}
+
+void TlsSessionClient::fail_(int error) {
+  ++stats_.failures;
+  stats_.lastError = error;
+  LOG_W("[TLS] Connection setup failed (-0x%04x)", error < 0 ? -error : error);
+}
+
+bool TlsSessionClient::poll() {
+  if (!connected_) {
+    return false;
+  }
+  return mbedtls_ssl_get_bytes_avail(&ssl_) > 0 ||
+         mbedtls_net_poll(&net_, MBEDTLS_NET_POLL_READ, 0) > 0;
+}
+
+bool TlsSessionClient::available() {
+  return connected_;
+}
+
+void TlsSessionClient::send(const websockets::WSString &data) {
+  send(reinterpret_cast<const uint8_t *>(data.c_str()), data.size());
+}
+
+void TlsSessionClient::send(const websockets::WSString &&data) {
+  send(reinterpret_cast<const uint8_t *>(data.c_str()), data.size());
+}
+
+void TlsSessionClient::send(const uint8_t *data, const uint32_t len) {
+  uint32_t sent = 0;
+  while (connected_ && sent < len) {
+    const int ret = mbedtls_ssl_write(&ssl_, data + sent, len - sent);
+    if (ret > 0) {
+      sent += ret;
+    } else if (!retryable(ret)) {
+      close();
+    }
+  }
+}
+
+websockets::WSString TlsSessionClient::readLine() {
+  websockets::WSString line;
+  const uint32_t start = millis();
+  while (connected_ && millis() - start < kHandshakeTimeoutMs) {
+    uint8_t c;
+    const uint32_t n = read(&c, 1);
+    if (n != 1) {
+      continue;
+    }
+    line += static_cast<char>(c);
+    if (c == '\n') {
+      break;
+    }
+  }
+  return line;
+}
+
+// Like WiFiClient, returns (uint32_t)-1 when nothing could be read; the
+// library retries while available() is true.
+uint32_t TlsSessionClient::read(uint8_t *buffer, const uint32_t len) {
+  if (!connected_) {
+    return static_cast<uint32_t>(-1);
+  }
+  const int ret = mbedtls_ssl_read(&ssl_, buffer, len);
+  if (ret > 0) {
+    return static_cast<uint32_t>(ret);
+  }
+  if (!retryable(ret)) {
+    close();  // 0 / close_notify / fatal error
+  }
+  return static_cast<uint32_t>(-1);
+}
+
+void TlsSessionClient::close() {
+  if (!connected_) {
+    return;
+  }
+  connected_ = false;
+  mbedtls_ssl_close_notify(&ssl_);
+  mbedtls_net_free(&net_);
+}
+
+void TlsSessionClient::forgetSession() {
+  mbedtls_ssl_session_free(&session_);
+  mbedtls_ssl_session_init(&session_);
+  haveSession_ = false;
+}
+
+uint32_t TlsSessionClient::avgFullMs() const {
+  const uint32_t full = stats_.handshakes - stats_.resumed;
+  return full ? static_cast<uint32_t>(stats_.totalFullMs / full) : 0;
+}
+
+uint32_t TlsSessionClient::avgResumedMs() const {
+  return stats_.resumed ? static_cast<uint32_t>(stats_.totalResumedMs / stats_.resumed) : 0;
+}
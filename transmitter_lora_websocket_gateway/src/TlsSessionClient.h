@@ -0,0 +1,94 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoWebsockets.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/x509_crt.h>
+
+// TLS transport for WebsocketsClient (wss://) that keeps reconnects cheap.
+//
+// The library's own wss:// path builds a fresh WiFiClientSecure per
+// connection, so every reconnect pays a full handshake (certificate chain,
+// RSA/ECDHE: seconds on an ESP32). This client keeps the negotiated
+// mbedTLS session in RAM and offers it on the next connect; a bridge that
+// still knows the session ID or accepts the session ticket resumes with an
+// abbreviated handshake (no certificate, no key exchange).
+//
+// Trust is pinned either to a CA certificate (PEM, chain verified against
+// serverName) or to the SHA-256 fingerprint of the bridge certificate. With
+// neither the link is encrypted but unauthenticated, which is only meant
+// for bench tests.
+//
+// Network task only; stats() may be read from other tasks for reporting.
+class TlsSessionClient : public websockets::network::TcpClient {
+public:
+  struct Stats {
+    uint32_t handshakes = 0;      // completed TLS handshakes
+    uint32_t resumed = 0;         // of which resumed the cached session
+    uint32_t failures = 0;        // TCP or TLS setup failures
+    uint32_t lastTcpMs = 0;       // DNS + TCP connect
+    uint32_t lastHandshakeMs = 0; // TLS handshake only
+    bool lastResumed = false;
+    int lastError = 0;            // mbedTLS error code, 0 = none
+    uint64_t totalFullMs = 0;
+    uint64_t totalResumedMs = 0;
+  };
+
+  static constexpr uint32_t kHandshakeTimeoutMs = 10000;
+  static constexpr uint32_t kReadTimeoutMs = 1000;
+
+  // caPem and fingerprint may be null; fingerprint is 64 hex digits, ':'
+  // and ' ' separators and openssl's "SHA256 Fingerprint=" prefix are
+  // ignored. A CA or fingerprint that is given but does not parse makes
+  // every connect fail. serverName is used for SNI and for the certificate
+  // name check.
+  TlsSessionClient(const char *caPem, const char *fingerprint, const char *serverName);
+  ~TlsSessionClient();
+
+  // websockets::network::TcpClient
+  bool connect(const websockets::WSString &host, const int port);
+  bool poll();
+  bool available();
+  void send(const websockets::WSString &data);
+  void send(const websockets::WSString &&data);
+  void send(const uint8_t *data, const uint32_t len);
+  websockets::WSString readLine();
+  uint32_t read(uint8_t *buffer, const uint32_t len);
+  void close();
+  int getSocket() const { return net_.fd; }
+
+  // Drop the cached session so the next connect does a full handshake.
+  void forgetSession();
+  bool hasSession() const { return haveSession_; }
+  const Stats &stats() const { return stats_; }
+  uint32_t avgFullMs() const;
+  uint32_t avgResumedMs() const;
+
+private:
+  bool init_();
+  bool handshake_(bool &resumed);
+  bool verifyFingerprint_();
+  void fail_(int error);
+
+  const char *caPem_;
+  const char *serverName_;
+  uint8_t fingerprint_[32] = {};
+  bool pinFingerprint_ = false;    // configured, valid or not
+  bool fingerprintValid_ = false;
+
+  bool initialised_ = false;
+  bool connected_ = false;
+  bool haveSession_ = false;
+
+  mbedtls_net_context net_;
+  mbedtls_ssl_context ssl_;
+  mbedtls_ssl_config conf_;
+  mbedtls_ssl_session session_;
+  mbedtls_entropy_context entropy_;
+  mbedtls_ctr_drbg_context drbg_;
+  mbedtls_x509_crt ca_;
+
+  Stats stats_;
+};
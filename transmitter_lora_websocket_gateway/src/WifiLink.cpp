@@ -0,0 +1,176 @@
+#include "WifiLink.h"
+#include "AsyncLog.h"
+#include <WiFi.h>
+#include <Preferences.h>
+
+namespace {
+constexpr uint32_t kCacheMagic = 0x57464c31;  // "WFL1"
+constexpr char kNamespace[] = "wifilink";
+constexpr char kCacheKey[] = "cache";
+}  // namespace
+
+void WifiLink::begin(const char *ssid, const char *password, bool useCachedAddress) {
+  ssid_ = ssid;
+  password_ = password;
+  useCachedAddress_ = useCachedAddress;
+
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);  // poll() owns reconnects
+  loadCache_();
+
+  downSince_ = millis();
+  startJoin_(downSince_);
+}
+
+void WifiLink::poll() {
+  const uint32_t now = millis();
+  const bool up = WiFi.status() == WL_CONNECTED;
+
+  switch (state_) {
+    case State::Idle:
+      break;
+
+    case State::Connected:
+      if (!up) {
+        ++stats_.drops;
+        downSince_ = now;
+        LOG_W("[WiFi] Link lost, rejoining");
+        startJoin_(now);
+      }
+      break;
+
+    case State::FastJoin:
+      if (up) {
+        onConnected_(now);
+      } else if (now - attemptAt_ >= kFastJoinTimeoutMs) {
+        LOG_W("[WiFi] Fast join timed out; dropping cached AP");
+        cacheValid_ = false;
+        WiFi.disconnect();
+        startJoin_(now);
+      }
+      break;
+
+    case State::FullJoin:
+      if (up) {
+        onConnected_(now);
+      } else if (now - attemptAt_ >= kFullJoinTimeoutMs) {
+        onFailed_(now);
+      }
+      break;
+
+    case State::Backoff:
+      if (backoff_.ready(now)) {
+        startJoin_(now);
+      }
+      break;
+  }
+}
+
+void WifiLink::connectFailed() {
+  if (state_ != State::Connected || !cachedAddress_) {
+    return;
+  }
+  LOG_W("[WiFi] Connection failed on cached address; rejoining with DHCP");
+  cacheValid_ = false;
+  WiFi.disconnect();
+  downSince_ = millis();
+  startJoin_(downSince_);
+}
+
+void WifiLink::startJoin_(uint32_t now) {
+  attemptAt_ = now;
+  if (cacheValid_) {
+    if (useCachedAddress_) {
+      WiFi.config(IPAddress(cache_.ip), IPAddress(cache_.gateway), IPAddress(cache_.subnet),
+                  IPAddress(cache_.dns));
+    }
+    WiFi.begin(ssid_, password_, cache_.channel, cache_.bssid, true);
+    state_ = State::FastJoin;
+  } else {
+    WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+    WiFi.begin(ssid_, password_);
+    state_ = State::FullJoin;
+  }
+}
+
+void WifiLink::onConnected_(uint32_t now) {
+  const uint32_t joinMs = now - downSince_;
+  ++stats_.joins;
+  if (state_ == State::FastJoin) {
+    ++stats_.fastJoins;
+  }
+  stats_.lastJoinMs = joinMs;
+  stats_.maxJoinMs = max(stats_.maxJoinMs, joinMs);
+  stats_.totalJoinMs += joinMs;
+  LOG_I("[WiFi] Connected (%s) in %lu ms. IP=%s ch=%ld RSSI=%d dBm",
+        state_ == State::FastJoin ? "fast" : "scan",
+        static_cast<unsigned long>(joinMs), WiFi.localIP().toString().c_str(),
+        static_cast<long>(WiFi.channel()), WiFi.RSSI());
+
+  cachedAddress_ = state_ == State::FastJoin && useCachedAddress_;
+  state_ = State::Connected;
+  backoff_.reset();
+  saveCache_();
+}
+
+void WifiLink::onFailed_(uint32_t now) {
+  ++stats_.failures;
+  WiFi.disconnect();
+  backoff_.schedule(now);
+  state_ = State::Backoff;
+  LOG_W("[WiFi] Join failed; retry in %lu ms",
+        static_cast<unsigned long>(backoff_.delayMs()));
+}
+
+uint32_t WifiLink::downForMs() const {
+  return state_ == State::Connected ? 0 : millis() - downSince_;
+}
+
+uint32_t WifiLink::avgJoinMs() const {
+  return stats_.joins ? static_cast<uint32_t>(stats_.totalJoinMs / stats_.joins) : 0;
+}
+
+const char *WifiLink::stateName() const {
+  switch (state_) {
+    case State::FastJoin: return "fastJoin";
+    case State::FullJoin: return "join";
+    case State::Connected: return "connected";
+    case State::Backoff: return "backoff";
+    default: return "idle";
+  }
+}
+
+void WifiLink::loadCache_() {
+  Preferences prefs;
+  prefs.begin(kNamespace, true);
+  cacheValid_ = prefs.getBytes(kCacheKey, &cache_, sizeof(cache_)) == sizeof(cache_) &&
+                cache_.magic == kCacheMagic;
+  prefs.end();
+}
+
+// Only touches flash when the AP or lease actually changed.
+void WifiLink::saveCache_() {
+  Cache fresh;
+  memset(&fresh, 0, sizeof(fresh));  // padding too: compared with memcmp
+  fresh.magic = kCacheMagic;
+  const uint8_t *bssid = WiFi.BSSID();
+  if (bssid) {
+    memcpy(fresh.bssid, bssid, sizeof(fresh.bssid));
+  }
+  fresh.channel = static_cast<uint8_t>(WiFi.channel());
+  fresh.ip = WiFi.localIP();
+  fresh.gateway = WiFi.gatewayIP();
+  fresh.subnet = WiFi.subnetMask();
+  fresh.dns = WiFi.dnsIP();
+
+  const bool changed = !cacheValid_ || memcmp(&fresh, &cache_, sizeof(cache_)) != 0;
+  cache_ = fresh;
+  cacheValid_ = bssid != nullptr;
+  if (!changed || !cacheValid_) {
+    return;
+  }
+  Preferences prefs;
+  prefs.begin(kNamespace, false);
+  prefs.putBytes(kCacheKey, &cache_, sizeof(cache_));
+  prefs.end();
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <Arduino.h>
+
+// Exponential retry delay with +/-25 % jitter.
+class Backoff {
+public:
+  Backoff(uint32_t initialMs, uint32_t maxMs) : initialMs_(initialMs), maxMs_(maxMs) {}
+
+  void reset() {
+    delayMs_ = 0;
+    readyAt_ = 0;
+    armed_ = false;
+  }
+
+  // Arm the next attempt after a failure.
+  void schedule(uint32_t now) {
+    delayMs_ = delayMs_ == 0 ? initialMs_ : min(delayMs_ * 2, maxMs_);
+    const int32_t jitter = static_cast<int32_t>(delayMs_ / 4);
+    readyAt_ = now + delayMs_ + (jitter ? random(-jitter, jitter + 1) : 0);
+    armed_ = true;
+  }
+
+  bool ready(uint32_t now) const {
+    return !armed_ || static_cast<int32_t>(now - readyAt_) >= 0;
+  }
+  uint32_t delayMs() const { return delayMs_; }
+
+private:
+  uint32_t initialMs_;
+  uint32_t maxMs_;
+  uint32_t delayMs_ = 0;
+  uint32_t readyAt_ = 0;
+  bool armed_ = false;
+};
+
+// Non-blocking station join. poll() only ever starts a join or checks on
+// one, so the caller's task keeps running while the radio associates.
+//
+// The last good BSSID, channel and DHCP lease are cached in NVS: the next
+// join goes straight to that AP on that channel (no scan) and, with
+// useCachedAddress, skips DHCP. If the fast join does not complete within
+// kFastJoinTimeoutMs the cache is dropped and a normal scan + DHCP join is
+// tried; failed joins back off exponentially. Association alone does not
+// prove a cached address is still ours (the lease may have gone to another
+// host), so the caller reports a failed connection through connectFailed().
+class WifiLink {
+public:
+  enum class State : uint8_t { Idle, FastJoin, FullJoin, Connected, Backoff };
+
+  struct Stats {
+    uint32_t joins = 0;          // successful associations
+    uint32_t fastJoins = 0;      // of which used the cached BSSID/channel
+    uint32_t failures = 0;       // join attempts that timed out
+    uint32_t drops = 0;          // connection losses
+    uint32_t lastJoinMs = 0;     // link down (or boot) -> IP
+    uint32_t maxJoinMs = 0;
+    uint64_t totalJoinMs = 0;
+  };
+
+  static constexpr uint32_t kFastJoinTimeoutMs = 3000;
+  static constexpr uint32_t kFullJoinTimeoutMs = 15000;
+
+  void begin(const char *ssid, const char *password, bool useCachedAddress);
+  void poll();
+  // A connection over the link failed. If the link runs on a cached
+  // address, drop the cache and rejoin with DHCP.
+  void connectFailed();
+
+  bool connected() const { return state_ == State::Connected; }
+  State state() const { return state_; }
+  const char *stateName() const;
+  // Milliseconds since the link went down (0 while connected).
+  uint32_t downForMs() const;
+  const Stats &stats() const { return stats_; }
+  uint32_t avgJoinMs() const;
+
+private:
+  struct Cache {
+    uint32_t magic;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+  };
+
+  void startJoin_(uint32_t now);
+  void onConnected_(uint32_t now);
+  void onFailed_(uint32_t now);
+  void loadCache_();
+  void saveCache_();
+
+  const char *ssid_ = nullptr;
+  const char *password_ = nullptr;
+  bool useCachedAddress_ = false;
+
+  State state_ = State::Idle;
+  Cache cache_{};
+  bool cacheValid_ = false;
+  bool cachedAddress_ = false;  // connected without DHCP
+  uint32_t attemptAt_ = 0;
+  uint32_t downSince_ = 0;
+  Backoff backoff_{500, 30000};
+  Stats stats_;
+};
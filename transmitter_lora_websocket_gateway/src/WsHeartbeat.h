@@ -0,0 +1,110 @@
+#pragma once
+#include <Arduino.h>
+
+// WebSocket ping/pong liveness and round-trip time.
+//
+// TCP alone does not notice a half-open connection (bridge host gone, NAT
+// entry expired) until a write finally times out, minutes later, and the
+// tank keeps executing its last command meanwhile. The gateway pings every
+// intervalUs with a numbered payload; the matching pong gives one RTT
+// sample, smoothed like TCP's SRTT (alpha = 1/8). Each ping still
+// unanswered when the next one is due counts as missed; maxMissed misses
+// in a row declare the link dead.
+//
+// Detection time is measured from the last sign of life (the last pong, or
+// the connection opening) to the dead verdict, so it includes the pings
+// that went unanswered. Network task only; stats() may be read elsewhere
+// for reporting.
+class WsHeartbeat {
+public:
+  enum class Action : uint8_t { None, SendPing, Dead };
+
+  struct Stats {
+    uint32_t pings = 0;
+    uint32_t pongs = 0;
+    uint32_t missed = 0;           // all missed pongs
+    uint32_t deadLinks = 0;
+    uint32_t rttUs = 0;            // EWMA
+    uint32_t rttMinUs = 0;
+    uint32_t rttMaxUs = 0;
+    uint32_t lastRttUs = 0;
+    uint32_t lastDetectMs = 0;     // last sign of life -> declared dead
+  };
+
+  WsHeartbeat(uint32_t intervalMs, uint8_t maxMissed)
+      : intervalUs_(static_cast<uint64_t>(intervalMs) * 1000), maxMissed_(maxMissed) {}
+
+  // Connection opened: the first ping goes out one interval from now.
+  void start(uint64_t nowUs) {
+    running_ = true;
+    outstanding_ = false;
+    missedInRow_ = 0;
+    lastAliveUs_ = nowUs;
+    nextPingUs_ = nowUs + intervalUs_;
+  }
+
+  void stop() { running_ = false; }
+
+  // Call every network loop. On SendPing, send payload() as the ping data.
+  Action poll(uint64_t nowUs) {
+    if (!running_ || nowUs < nextPingUs_) {
+      return Action::None;
+    }
+    if (outstanding_) {
+      ++stats_.missed;
+      if (++missedInRow_ >= maxMissed_) {
+        running_ = false;
+        ++stats_.deadLinks;
+        stats_.lastDetectMs = static_cast<uint32_t>((nowUs - lastAliveUs_) / 1000);
+        return Action::Dead;
+      }
+    }
+    ++pingId_;
+    snprintf(payload_, sizeof(payload_), "%lu", static_cast<unsigned long>(pingId_));
+    outstanding_ = true;
+    sentUs_ = nowUs;
+    nextPingUs_ = nowUs + intervalUs_;
+    ++stats_.pings;
+    return Action::SendPing;
+  }
+
+  const char *payload() const { return payload_; }
+
+  // Pong received with the given payload. Pongs for older pings (late
+  // answers) still prove the link is alive but give no RTT sample.
+  void onPong(const char *data, uint64_t nowUs) {
+    ++stats_.pongs;
+    lastAliveUs_ = nowUs;
+    missedInRow_ = 0;
+    if (!outstanding_ || strtoul(data, nullptr, 10) != pingId_) {
+      return;
+    }
+    outstanding_ = false;
+    const uint32_t rtt = static_cast<uint32_t>(nowUs - sentUs_);
+    stats_.lastRttUs = rtt;
+    if (stats_.rttUs == 0) {
+      stats_.rttUs = rtt;
+      stats_.rttMinUs = rtt;
+    } else {
+      stats_.rttUs = static_cast<uint32_t>((7ull * stats_.rttUs + rtt) / 8);
+      stats_.rttMinUs = min(stats_.rttMinUs, rtt);
+    }
+    stats_.rttMaxUs = max(stats_.rttMaxUs, rtt);
+  }
+
+  bool running() const { return running_; }
+  const Stats &stats() const { return stats_; }
+
+private:
+  uint64_t intervalUs_;
+  uint8_t maxMissed_;
+  bool running_ = false;
+  bool outstanding_ = false;
+  uint8_t missedInRow_ = 0;
+  uint32_t pingId_ = 0;
+  uint64_t sentUs_ = 0;
+  uint64_t nextPingUs_ = 0;
+  uint64_t lastAliveUs_ = 0;
+  char payload_[12] = {};
+  Stats stats_;
+};
@@ -5,18 +5,87 @@
 #define WIFI_SSID           "UPBWiFi"
 #define WIFI_PASSWORD       ""
 
+// Reuse the last DHCP lease (cached in NVS with the AP's BSSID/channel) on
+// reconnect instead of waiting for DHCP. Disable on networks that hand out
+// short leases or reassign addresses. A failed WebSocket connect on a cached
+// address drops the cache and rejoins with DHCP.
+#define WIFI_CACHE_STATIC_IP 1
+
 // ---------- WebSocket Server Configuration ----------
 #define WS_SERVER_HOST      "98.92.226.197"
 #define WS_SERVER_PORT      8000
 #define TANK_ID             "tank_001"
 
+// Tanks served by this gateway over the one WebSocket: { bridge id, radio
+// address }. The address must match TANK_RADIO_ADDRESS in that tank's
+// receiver; address 0 reaches receivers that accept every frame, so the
+// single-tank default needs no receiver change. The first entry is TANK_ID.
+#define TANK_TABLE          { {TANK_ID, 0} }
+// e.g. { {TANK_ID, 1}, {"tank_002", 2}, {"tank_003", 3} }
+
 // If using local testing:
 // #define WS_SERVER_HOST      "192.168.1.100"
 // #define WS_SERVER_PORT      8000
 
-// For WSS (secure WebSocket), use port 443 and modify webSocket.begin() to use SSL
+// Dead-link detection: ping the bridge every WS_PING_INTERVAL_MS; after
+// WS_PING_MAX_MISSED unanswered pings in a row every tank is stopped and
+// the gateway reconnects at once. Worst-case detection is about
+// interval * (missed + 1).
+#define WS_PING_INTERVAL_MS 1000
+#define WS_PING_MAX_MISSED  3
+
+// Flight recorder: last N events (16 bytes each) kept for post-mortems.
+// PSRAM when the board has it, a smaller ring in internal RAM otherwise.
+// Fetch with GET /tanks/<tankId>/flight on the bridge.
+#define FLIGHT_RECORDER_RECORDS          16384   // 256 KB of PSRAM
+#define FLIGHT_RECORDER_FALLBACK_RECORDS 512     // 8 KB of internal RAM
+
+// ---------- WSS (TLS) ----------
+// Set to 1 to connect with wss:// (usually on port 443). The TLS session is
+// kept across reconnects so a bridge that supports session IDs or tickets
+// resumes with an abbreviated handshake; "link.tls" in the status reports
+// full vs resumed handshakes and their timings.
+#define WS_USE_TLS          0
+
+// Trust: pin either the CA that signed the bridge certificate (PEM) or the
+// SHA-256 fingerprint of the bridge certificate itself (hex, ':' allowed).
+// With neither the link is encrypted but not authenticated.
+// #define WS_TLS_CA_CERT  "-----BEGIN CERTIFICATE-----\n...\n-----END CERTIFICATE-----\n"
+// #define WS_TLS_FINGERPRINT "AB:CD:..."   // openssl x509 -noout -fingerprint -sha256 -in bridge.crt
+// A CA or fingerprint that does not parse refuses every connection.
+
+// Name checked against the certificate and sent as SNI. mbedTLS does not
+// match IP address SANs, so with an IP in WS_SERVER_HOST set this to the
+// certificate's DNS name.
+#define WS_TLS_SERVER_NAME  WS_SERVER_HOST
+
+// Local stand-in for the bridge: serve server.py over TLS with a
+// self-signed certificate and pin its fingerprint (or use it as the CA):
+//   openssl req -x509 -newkey rsa:2048 -nodes -days 365 -subj "/CN=bridge.local"
+//     -addext "subjectAltName=DNS:bridge.local" -keyout bridge.key -out bridge.crt
+//   (one command)
+//   SSL_CERTFILE=bridge.crt SSL_KEYFILE=bridge.key python server.py
+// then WS_SERVER_HOST = the PC's IP, WS_TLS_SERVER_NAME = "bridge.local".
+
+// ---------- LoRa Channel Selection ----------
+// RSSI sampling window per channel of TankControl::kChannelPlanMHz at boot.
+#define CHANNEL_SCAN_WINDOW_MS  150
+
+// ---------- Shared Radio: Sensor Receiver ----------
+// Set to 1 to time-slice this board's SX127x between the control link and
+// the Part 2 sensor link (replacing the separate lora_receiver board).
+// Control frames always preempt sensor reception. Sensor readings are
+// forwarded to the bridge as {"type":"sensor"} messages.
+#define ENABLE_SENSOR_RX        0
+#define SENSOR_RADIO_FREQ_MHZ   915.0   // sensor rendezvous channel
+#define SENSOR_RADIO_SF         10
+#define SENSOR_RADIO_CR         7       // 4/7
+#define SENSOR_SYNC_WORD        0xAB
 
 // ---------- Safety Configuration ----------
+// Receivers ramp to a stop after this long without a frame while moving;
+// the gateway sends heartbeats every quarter of it. Build the receivers
+// with the same value (ControlProtocol.h defaults to 2000).
 #define WATCHDOG_TIMEOUT_MS 2000    // Emergency stop after 2 seconds
 #define STATUS_INTERVAL_MS  5000    // Send status every 5 seconds
 
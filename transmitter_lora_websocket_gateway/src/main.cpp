@@ -9,7 +9,24 @@
 #include <LoRa.h>
 #include "config.h"
 #include "ControlProtocol.h"
+#include "ChannelScan.h"
+#include "RadioScheduler.h"
+#include "SpscRing.h"
+#include "CommandMailbox.h"
+#include "TankMotion.h"
+#include "BridgeProtocol.h"
+#include "BridgeJson.h"
+#include "JsonArena.h"
+#include "StatusDelta.h"
+#include "LatencyHistogram.h"
+#include "WifiLink.h"
+#include "WsHeartbeat.h"
+#include "FlightRecorder.h"
+#include "TlsSessionClient.h"
+#include "AsyncLog.h"
 #include "LoRaBoards.h"
+#include <atomic>
+#include <esp_timer.h>
 
 #if !defined(ESP32)
 #error "Current build targets the LilyGO T-Beam (ESP32)."
@@ -28,25 +45,255 @@
 // ----- Runtime State -------------------------------------------------
 using namespace websockets;
 
-WebsocketsClient wsClient;
-bool wsConnected = false;
-String currentState = "STOP";
-uint8_t currentLeftSpeed = 0;
-uint8_t currentRightSpeed = 0;
-uint8_t sequenceCounter = 0;
-uint32_t lastStatusAt = 0;
-constexpr uint32_t kStatusIntervalMs = 5000;
+// Three pinned tasks: network (WiFi + WebSocket, core 0 next to the WiFi
+// stack), command (JSON, AES, status) and radio (LoRa TX + sensor RX),
+// both on core 1. They only talk through the SPSC rings and the command
+// mailbox below, so a slow LoRa airtime never stalls wsClient.poll() and
+// vice versa.
+constexpr size_t kWsInboundMax = 256;
+constexpr size_t kWsOutboundMax = 1024;
+
+struct WsInbound {
+    enum class Kind : uint8_t { Text, Binary, LinkDown };
+    Kind kind;
+    uint16_t length;
+    uint64_t receivedUs;                       // esp_timer, in the WS callback
+    char data[kWsInboundMax];
+};
+
+// esp_timer stamps taken along one command's way to the air.
+struct CommandStamps {
+    uint64_t receivedUs;   // WebSocket callback (network task)
+    uint64_t dequeuedUs;   // command task picked it up
+    uint64_t parsedUs;     // JSON / binary decode done
+    uint64_t postedUs;     // encrypted and in the mailbox
+    uint64_t onAirUs;      // the frame itself starts on air (after any announce)
+    uint64_t txDoneUs;     // LoRa TX done (radio task)
+};
+
+struct WsOutbound {
+    bool binary;
+    uint16_t length;
+    char data[kWsOutboundMax];
+};
+
+struct TxRequest {
+    uint8_t payload[TankControl::kFrameSize];  // already encrypted
+    uint8_t tank;                              // index into kTankConfig
+    TankControl::Command command;
+    uint8_t leftSpeed;
+    uint8_t rightSpeed;
+    uint8_t sequence;
+    uint16_t hostSequence;                     // bridge-assigned "seq", 0 if absent
+    CommandStamps stamps;
+    bool heartbeat;                            // watchdog refresh, not a bridge command
+    uint32_t generation;                       // TankMotion::queued()
+};
+
+struct TxResult {
+    uint8_t tank;
+    TankControl::Command command;
+    uint8_t leftSpeed;
+    uint8_t rightSpeed;
+    uint8_t sequence;
+    uint16_t hostSequence;
+    CommandStamps stamps;
+    bool ok;
+    bool preempted;        // setpoint skipped for a Stop; not on air
+    bool heartbeat;
+    uint32_t generation;
+};
+
+// Per-stage latency, recorded by the command task when the TX result
+// comes back: queue (WS callback -> command task), parse, encrypt (AES +
+// mailbox post), radio (mailbox wait + announce + airtime) and total.
+enum LatencyStage : size_t {
+    kStageQueue,
+    kStageParse,
+    kStageEncrypt,
+    kStageRadio,
+    kStageTotal,
+    kStageCount
+};
+const char *const kStageNames[kStageCount] = {"queue", "parse", "encrypt", "radio", "total"};
+LatencyHistogram latency[kStageCount];        // command task only
+// Stop receipt (WS callback, or link loss) -> Stop frame starts on air: the
+// figure the safety review tracks, kept apart from the mixed-command stages.
+LatencyHistogram stopToAir;                   // command task only
+uint32_t setpointsPreempted = 0;              // command task only
+CommandStamps inboundStamps{};                // command task: message being handled
+
+// Each task adds to its own counters; the command task reads all three
+// from the other core for the snapshot, hence atomics (a plain 64-bit total
+// can tear on this 32-bit CPU). awakeUs is wall time from wake-up to going
+// back to sleep, so it includes time the task spent preempted.
+struct TaskMetrics {
+    explicit TaskMetrics(const char *taskName) : name(taskName) {}
+
+    const char *name;
+    TaskHandle_t handle = nullptr;
+    std::atomic<uint64_t> awakeUs{0};
+    std::atomic<uint32_t> wakeups{0};
+};
+
+// Tanks multiplexed on this gateway (config.h TANK_TABLE).
+struct TankConfig {
+    const char *id;
+    uint8_t address;                   // ControlFrame::address
+};
+constexpr TankConfig kTankConfig[] = TANK_TABLE;
+constexpr size_t kTankCount = sizeof(kTankConfig) / sizeof(kTankConfig[0]);
+static_assert(kTankCount >= 1 && kTankCount <= 8, "TANK_TABLE must list 1-8 tanks");
+
+// Each id takes its quotes and a comma in the hello (kHelloBytesPerTank).
+constexpr size_t kHelloBytesPerTank = 40;
+constexpr size_t kMaxTankIdLength = kHelloBytesPerTank - 3;
+constexpr size_t literalLength(const char *text, size_t length = 0) {
+    return text[length] ? literalLength(text, length + 1) : length;
+}
+constexpr bool tankIdsFit(size_t tank = 0) {
+    return tank >= kTankCount ||
+           (literalLength(kTankConfig[tank].id) <= kMaxTankIdLength && tankIdsFit(tank + 1));
+}
+static_assert(tankIdsFit(), "TANK_TABLE ids must be at most 37 characters");
+
+// Per-tank state: the command task owns the setpoint and radio sequence,
+// the radio task owns the TX bookkeeping, the mailbox joins the two.
+struct TankSlot {
+    TankControl::Command command = TankControl::Command::Stop;
+    uint8_t leftSpeed = 0;
+    uint8_t rightSpeed = 0;
+    uint8_t sequence = 0;
+    TankMotion motion;                  // what a heartbeat repeats; owed Stops
+    uint64_t lastQueuedUs = 0;
+    CommandMailbox<TxRequest> mailbox;  // command -> radio, latest wins
+    uint32_t lastTxAt = 0;              // radio task
+    uint32_t frames = 0;
+    uint64_t airtimeUs = 0;
+    uint32_t heartbeats = 0;            // of frames
+    uint64_t heartbeatAirtimeUs = 0;    // of airtimeUs
+};
+TankSlot tanks[kTankCount];
+size_t lastServedTank = kTankCount - 1;  // radio task, round-robin cursor
+
+SpscRing<WsInbound, 8> wsInbound;     // network -> command
+SpscRing<TxResult, 8> txResults;      // radio   -> command
+SpscRing<WsOutbound, 4> statusOut;    // command -> network
+SpscRing<WsOutbound, 4> sensorOut;    // radio   -> network
+
+TaskMetrics networkTask{"net"};
+TaskMetrics commandTask{"cmd"};
+TaskMetrics radioTask{"radio"};
+uint64_t tasksStartedUs = 0;
+
+#if WS_USE_TLS
+#ifndef WS_TLS_CA_CERT
+#define WS_TLS_CA_CERT nullptr
+#endif
+#ifndef WS_TLS_FINGERPRINT
+#define WS_TLS_FINGERPRINT nullptr
+#endif
+// Outlives every reconnect, so its cached TLS session does too.
+std::shared_ptr<TlsSessionClient> wsTls =
+    std::make_shared<TlsSessionClient>(WS_TLS_CA_CERT, WS_TLS_FINGERPRINT, WS_TLS_SERVER_NAME);
+WebsocketsClient wsClient(wsTls);             // network task only
+#else
+WebsocketsClient wsClient;                    // network task only
+#endif
+WifiLink wifiLink;                            // network task only (after setup)
+Backoff wsBackoff{1000, 30000};
+bool wsCallbacksSet = false;
+uint32_t wsConnects = 0;
+uint32_t wsFailures = 0;
+uint32_t wsLastConnectMs = 0;                 // attempt start -> connection open
+WsHeartbeat wsHeartbeat{WS_PING_INTERVAL_MS, WS_PING_MAX_MISSED};  // network task only
+// Keep the WebSocket through WiFi blips this short; the tank is stopped
+// as soon as WiFi drops either way.
+constexpr uint32_t kWsGraceMs = 3000;
+std::atomic<bool> wsConnected{false};
+std::atomic<bool> statusRequested{false};
+std::atomic<bool> binaryLink{false};          // bridge accepted BridgeProtocol
+uint8_t announceSequence = 0;                 // radio task (setup before it)
+uint32_t lastAnnounceAt = 0;                  // radio task (setup before it)
+
+// Status is event driven: every transmitted command gets a small ack (which
+// carries that tank's state and speeds), and the gateway fields below go
+// out as a delta once they change past their threshold (rate limited per
+// field). The full snapshot, with diagnostics, is only sent on (re)connect
+// and every kSnapshotIntervalMs, one outbound slot per part: a "status"
+// per tank, then "link", "radio" and "latency".
+enum DeltaIndex : size_t {
+    kDeltaWifiRssi,
+    kDeltaFreeHeap,
+    kDeltaSuperseded,
+    kDeltaCount
+};
+constexpr DeltaField kDeltaFields[kDeltaCount] = {
+    {"wifiRssi", 4, 5000},
+    {"freeHeap", 4096, 30000},
+    {"superseded", 1, 2000},
+};
+StatusDelta<kDeltaCount> statusDelta(kDeltaFields);
+uint32_t lastDeltaCheckAt = 0;
+uint32_t lastSnapshotAt = 0;
+enum SnapshotPart : size_t {
+    kPartLink = kTankCount,  // parts below this are per-tank statuses
+    kPartRadio,
+    kPartLatency,
+    kSnapshotParts
+};
+size_t snapshotNext = kSnapshotParts;         // command task: next part to send
+constexpr uint32_t kDeltaCheckMs = 250;
+constexpr uint32_t kSnapshotIntervalMs = STATUS_INTERVAL_MS * 6;
+
+// JSON documents are built in these per-task arenas, never on the heap.
+JsonArena<4096> commandArena;                 // command task only
+JsonArena<2048> radioArena;                   // radio task only
+FlightRecorder flight;                        // any task records
+// Flight recorder dump in progress (command task): [dumpNext, dumpEnd).
+bool dumpActive = false;
+bool dumpFirst = false;
+uint32_t dumpNext = 0;
+uint32_t dumpEnd = 0;
+uint64_t dumpNowUs = 0;
+
+// Connect hello: offers BridgeProtocol and registers every tank id.
+char helloMessage[64 + kTankCount * kHelloBytesPerTank];
+size_t helloLength = 0;
+
+RadioScheduler radio;
+ChannelScan::Report channelScan{};            // written once in setup()
+uint8_t dataChannel = 0;
 
 // ----- Forward Declarations ------------------------------------------
 void connectWiFi();
-void beginWebSocket();
+bool beginWebSocket();
 void handleWebsocketEvent(WebsocketsEvent event, String data);
 void handleWebsocketMessage(WebsocketsMessage message);
 void handleCommand(const char *json);
-bool transmitLoRa(TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed);
-TankControl::Command mapCommand(const String &cmd);
+void handleBinaryMessage(const uint8_t *data, size_t length);
+bool queueCommand(size_t tank, TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed,
+                  uint16_t hostSequence = 0, bool heartbeat = false);
+void queueHeartbeats();
+bool takeNextRequest(TxRequest &request);
+void buildHello();
+void applyTxResult(const TxResult &result);
+TxResult transmitLoRa(const TxRequest &request);
+bool sendLoRaPacket(const uint8_t *buffer, size_t length, long preambleSymbols);
+bool announceChannel(bool wake);
+void selectChannel();
+void forwardSensorPacket(const LoRaRx::Packet &packet);
+const char *stateName(TankControl::Command cmd);
 bool publishStatus(bool force = false);
 bool setupLoRa();
+void networkTaskMain(void *);
+void commandTaskMain(void *);
+void radioTaskMain(void *);
+void startTasks();
+void emergencyStop();
+bool stopPendingAnyTank();
+void startDump();
+void continueDump();
 
 // ----- Setup / Loop --------------------------------------------------
 void setup() {
@@ -57,257 +304,1205 @@ void setup() {
     while (!Serial) { delay(10); }
 
     Serial.println();
-    Serial.println("==============================================");
-    Serial.println("WebSocket → LoRa Gateway");
-    Serial.println("==============================================");
+    AsyncLog::begin();
+    LOG_I("==============================================");
+    LOG_I("WebSocket → LoRa Gateway");
+    LOG_I("==============================================");
 
     if (!setupLoRa()) {
-        Serial.println("[LoRa] Initialization failed. Halting.");
+        LOG_E("[LoRa] Initialization failed. Halting.");
         while (true) { delay(1000); }
     }
+    selectChannel();
+    buildHello();
+    const size_t flightRecords =
+        flight.begin(FLIGHT_RECORDER_RECORDS, FLIGHT_RECORDER_FALLBACK_RECORDS);
+    LOG_I("[FLIGHT] %u records in %s", static_cast<unsigned>(flightRecords),
+          flight.inPsram() ? "PSRAM" : "internal RAM");
 
     connectWiFi();
-    beginWebSocket();
+    startTasks();
 }
 
 void loop() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("[WiFi] Lost connection, attempting reconnect...");
-        wsConnected = false;
-        if (wsClient.available()) {
+    // All work happens in the pinned tasks started from setup().
+    vTaskDelete(nullptr);
+}
+
+// ----- Tasks -----------------------------------------------------------
+uint64_t nowUs() {
+    return static_cast<uint64_t>(esp_timer_get_time());
+}
+
+void startTasks() {
+    tasksStartedUs = nowUs();
+    xTaskCreatePinnedToCore(radioTaskMain, "radio", 6144, nullptr, 4, &radioTask.handle, 1);
+    xTaskCreatePinnedToCore(commandTaskMain, "cmd", 8192, nullptr, 3, &commandTask.handle, 1);
+    xTaskCreatePinnedToCore(networkTaskMain, "net", 8192, nullptr, 3, &networkTask.handle, 0);
+}
+
+void notifyTask(const TaskMetrics &task) {
+    if (task.handle) {
+        xTaskNotifyGive(task.handle);
+    }
+}
+
+// Tell the command task the uplink is gone so it stops the tank.
+void postLinkDown() {
+    if (WsInbound *slot = wsInbound.claim()) {
+        slot->kind = WsInbound::Kind::LinkDown;
+        slot->length = 0;
+        slot->receivedUs = nowUs();
+        wsInbound.commit();
+        notifyTask(commandTask);
+    }
+}
+
+void drainOutbound(SpscRing<WsOutbound, 4> &ring) {
+    while (WsOutbound *msg = ring.front()) {
+        if (wsConnected && wsClient.available()) {
+            if (msg->binary) {
+                wsClient.sendBinary(msg->data, msg->length);
+            } else {
+                wsClient.send(msg->data, msg->length);
+            }
+        }
+        ring.release();
+    }
+}
+
+// Half-open connections look healthy to the socket: stop the tanks and
+// drop the connection as soon as the bridge stops answering pings, and
+// reconnect without waiting out the backoff.
+void pollHeartbeat() {
+    switch (wsHeartbeat.poll(nowUs())) {
+        case WsHeartbeat::Action::SendPing:
+            wsClient.ping(wsHeartbeat.payload());
+            break;
+        case WsHeartbeat::Action::Dead:
+            LOG_W("[WS] No pong for %u pings (%lu ms); link dead", WS_PING_MAX_MISSED,
+                  static_cast<unsigned long>(wsHeartbeat.stats().lastDetectMs));
+            flight.record(FlightRecorder::Kind::LinkDead, FlightRecorder::kNoTank, 0, 0, 0,
+                          wsHeartbeat.stats().lastDetectMs);
+            if (wsConnected.exchange(false)) {
+                binaryLink = false;
+                postLinkDown();
+            }
             wsClient.close();
+            wsBackoff.reset();
+            break;
+        case WsHeartbeat::Action::None:
+            break;
+    }
+}
+
+void networkTaskMain(void *) {
+    for (;;) {
+        const uint64_t started = nowUs();
+        ++networkTask.wakeups;
+
+        const bool wasUp = wifiLink.connected();
+        wifiLink.poll();
+        const uint32_t now = millis();
+
+        if (!wifiLink.connected()) {
+            if (wasUp && wsConnected) {
+                postLinkDown();  // stop the tank now, keep the socket for a bit
+            }
+            if (wifiLink.downForMs() > kWsGraceMs && wsClient.available()) {
+                wsClient.close();
+            }
+        } else if (!wsClient.available()) {
+            if (wsConnected.exchange(false)) {
+                binaryLink = false;
+                postLinkDown();
+            }
+            if (wsBackoff.ready(now) && !beginWebSocket()) {
+                wsBackoff.schedule(now);
+            }
+        } else {
+            wsClient.poll();
+            pollHeartbeat();
+            drainOutbound(statusOut);
+            drainOutbound(sensorOut);
         }
-        connectWiFi();
-        beginWebSocket();
-        delay(500);
-        return;
+
+        networkTask.awakeUs += nowUs() - started;
+        vTaskDelay(pdMS_TO_TICKS(2));
     }
+}
+
+void commandTaskMain(void *) {
+    for (;;) {
+        // A dump or a snapshot refills the outbound ring as fast as the
+        // network task drains it.
+        const bool refilling = dumpActive || snapshotNext < kSnapshotParts;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(refilling ? 5 : 50));
+        const uint64_t started = nowUs();
+        ++commandTask.wakeups;
 
-    wsClient.poll();
-    publishStatus();
+        while (WsInbound *msg = wsInbound.front()) {
+            inboundStamps = CommandStamps{};
+            inboundStamps.receivedUs = msg->receivedUs;
+            inboundStamps.dequeuedUs = nowUs();
+            if (msg->kind == WsInbound::Kind::LinkDown) {
+                flight.record(FlightRecorder::Kind::LinkDown, FlightRecorder::kNoTank);
+                emergencyStop();
+            } else if (msg->kind == WsInbound::Kind::Binary) {
+                handleBinaryMessage(reinterpret_cast<const uint8_t *>(msg->data), msg->length);
+            } else {
+                handleCommand(msg->data);
+            }
+            wsInbound.release();
+        }
+
+        TxResult result;
+        while (txResults.pop(result)) {
+            applyTxResult(result);
+        }
+        queueHeartbeats();
+
+        publishStatus(statusRequested.exchange(false));
+        continueDump();
 #ifdef HAS_PMU
-    loopPMU();
+        loopPMU();
 #endif
-    delay(5);
+        commandTask.awakeUs += nowUs() - started;
+    }
+}
+
+void radioTaskMain(void *) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(radio.sharesRadio() ? 2 : 50));
+        const uint64_t started = nowUs();
+        const uint64_t txWaitBefore = radio.txWaitUs();
+        ++radioTask.wakeups;
+
+        TxRequest request;
+        while (takeNextRequest(request)) {
+            if (!txResults.push(transmitLoRa(request))) {
+                LOG_W("[LoRa] result queue full; status will lag");
+            }
+            notifyTask(commandTask);
+        }
+
+        if (LoRaRx::Packet *packet = radio.pollSensor()) {
+            forwardSensorPacket(*packet);
+            radio.releasePacket(packet);
+        }
+
+        // The task sleeps through time on air; leave it out.
+        radioTask.awakeUs += nowUs() - started - (radio.txWaitUs() - txWaitBefore);
+    }
+}
+
+// Airtime scheduling across tanks: pending Stops for every tank go first,
+// then one setpoint per tank in round-robin order starting after the tank
+// served last. With latest-wins mailboxes a tank can hold at most one
+// setpoint, so no tank waits more than kTankCount - 1 frames behind others.
+// A Stop therefore waits for at most the frame already on air; a setpoint
+// that needed a channel announce first is also preempted after the
+// announce (see transmitLoRa).
+bool takeNextRequest(TxRequest &request) {
+    for (size_t tank = 0; tank < kTankCount; ++tank) {
+        if (tanks[tank].mailbox.takeStop(request)) {
+            return true;
+        }
+    }
+    for (size_t i = 1; i <= kTankCount; ++i) {
+        const size_t tank = (lastServedTank + i) % kTankCount;
+        if (tanks[tank].mailbox.take(request)) {
+            lastServedTank = tank;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool stopPendingAnyTank() {
+    for (const TankSlot &tank : tanks) {
+        if (tank.mailbox.stopPending()) {
+            return true;
+        }
+    }
+    return false;
 }
 
 // ----- Wi-Fi & WebSocket ---------------------------------------------
+// Starts the join and returns; WifiLink finishes it from the network task.
 void connectWiFi() {
-    Serial.printf("[WiFi] Connecting to %s\n", WIFI_SSID);
+    LOG_I("[WiFi] Connecting to %s", WIFI_SSID);
     WiFi.mode(WIFI_STA);
 #if defined(ESP32)
     WiFi.setSleep(false);
     esp_wifi_set_ps(WIFI_PS_NONE);
 #endif
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    const uint32_t start = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - start < 30000) {
-        Serial.print('.');
-        delay(500);
-    }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println();
-        Serial.printf("[WiFi] Connected. IP=%s RSSI=%d dBm\n",
-                      WiFi.localIP().toString().c_str(), WiFi.RSSI());
-        return;
-    }
-
-    Serial.println("\n[WiFi] Failed to connect. Restarting...");
-    delay(3000);
-    ESP.restart();
+    wifiLink.begin(WIFI_SSID, WIFI_PASSWORD, WIFI_CACHE_STATIC_IP);
 }
 
-void beginWebSocket() {
-    if (wsClient.available()) {
-        wsClient.close();
+// One connection attempt. The TCP + HTTP upgrade still blocks, but only the
+// network task; the radio and command tasks keep running.
+bool beginWebSocket() {
+    if (!wsCallbacksSet) {
+        wsClient.onEvent(handleWebsocketEvent);
+        wsClient.onMessage(handleWebsocketMessage);
+        wsCallbacksSet = true;
     }
 
-    String uri = String("ws://") + WS_SERVER_HOST + ":" + WS_SERVER_PORT + "/ws/tank/" + TANK_ID;
-    Serial.printf("[WS] Connecting to %s\n", uri.c_str());
-
-    wsClient.onEvent(handleWebsocketEvent);
-    wsClient.onMessage(handleWebsocketMessage);
+    // The first tank names the connection; the hello registers the rest.
+    // Host/port/path rather than a URI: a "wss://" URI would make the
+    // library swap in its own TLS client, which cannot resume sessions.
+    char path[64];
+    snprintf(path, sizeof(path), "/ws/tank/%s", kTankConfig[0].id);
+    LOG_I("[WS] Connecting to %s://%s:%d%s", WS_USE_TLS ? "wss" : "ws", WS_SERVER_HOST,
+          WS_SERVER_PORT, path);
 
-    if (!wsClient.connect(uri)) {
-        Serial.println("[WS] Connection attempt failed");
-        wsConnected = false;
-        return;
+    const uint32_t startedAt = millis();
+    if (!wsClient.connect(WS_SERVER_HOST, WS_SERVER_PORT, path)) {
+        ++wsFailures;
+        LOG_W("[WS] Connection attempt failed");
+        wifiLink.connectFailed();  // a stale cached address looks like this
+        return false;
     }
+    ++wsConnects;
+    wsLastConnectMs = millis() - startedAt;
+    flight.record(FlightRecorder::Kind::LinkUp, FlightRecorder::kNoTank, 0, 0, 0, wsLastConnectMs);
+    wsBackoff.reset();
+    return true;
 }
 
 void handleWebsocketEvent(WebsocketsEvent event, String data) {
     switch (event) {
         case WebsocketsEvent::ConnectionOpened:
-            Serial.println("[WS] Event: connection opened");
+            LOG_I("[WS] Event: connection opened");
             wsConnected = true;
-            publishStatus(true);
+            binaryLink = false;
+            wsHeartbeat.start(nowUs());
+            wsClient.send(helloMessage, helloLength);
+            statusRequested = true;
+            notifyTask(commandTask);
             break;
         case WebsocketsEvent::ConnectionClosed:
-            Serial.println("[WS] Event: connection closed");
-            wsConnected = false;
-            transmitLoRa(TankControl::Command::Stop, 0, 0);
-            currentState = "STOP";
+            LOG_I("[WS] Event: connection closed");
+            wsHeartbeat.stop();
+            binaryLink = false;
+            if (wsConnected.exchange(false)) {
+                postLinkDown();  // not already stopped by the heartbeat
+            }
             break;
         case WebsocketsEvent::GotPing:
-            Serial.println("[WS] Event: ping");
+            LOG_D("[WS] Event: ping");
             break;
         case WebsocketsEvent::GotPong:
-            Serial.println("[WS] Event: pong");
+            wsHeartbeat.onPong(data.c_str(), nowUs());
+            LOG_D("[WS] Event: pong (rtt %lu us)",
+                  static_cast<unsigned long>(wsHeartbeat.stats().lastRttUs));
             break;
         default:
             if (data.length() > 0) {
-                Serial.printf("[WS] Event %d data: %s\n",
-                              static_cast<int>(event), data.c_str());
+                LOG_D("[WS] Event %d data: %s",
+                      static_cast<int>(event), data.c_str());
             }
             break;
     }
 }
 
+// Appends to helloMessage; false (length untouched) when it would not fit.
+template <typename... Args>
+bool appendHello(size_t &length, const char *format, Args... args) {
+    const int written =
+        snprintf(helloMessage + length, sizeof(helloMessage) - length, format, args...);
+    if (written < 0 || static_cast<size_t>(written) >= sizeof(helloMessage) - length) {
+        return false;
+    }
+    length += written;
+    return true;
+}
+
+// {"type":"hello","proto":"bin1","tanks":["tank-a","tank-b"]}; the array
+// order is the tank index used by BridgeProtocol messages.
+// tankIdsFit() already sizes the buffer at compile time; a hello that
+// still does not fit is dropped rather than sent truncated.
+void buildHello() {
+    size_t length = 0;
+    bool ok = appendHello(length, "{\"type\":\"hello\",\"proto\":\"%s\",\"tanks\":[",
+                          BridgeProtocol::kName);
+    for (size_t tank = 0; ok && tank < kTankCount; ++tank) {
+        ok = appendHello(length, "%s\"%s\"", tank ? "," : "", kTankConfig[tank].id);
+    }
+    ok = ok && appendHello(length, "%s", "]}");
+    if (!ok) {
+        LOG_E("[WS] Hello does not fit %u bytes", static_cast<unsigned>(sizeof(helloMessage)));
+        length = 0;
+    }
+    helloLength = length;
+}
+
 void handleWebsocketMessage(WebsocketsMessage message) {
-    if (message.isText()) {
-        const String &payload = message.data();
-        Serial.printf("[WS] <<< %s\n", payload.c_str());
-        handleCommand(payload.c_str());
-    } else if (message.isBinary()) {
-        Serial.printf("[WS] <<< binary (%u bytes)\n",
-                      static_cast<unsigned>(message.length()));
+    const bool binary = message.isBinary();
+    if (!binary && !message.isText()) {
+        return;
     }
+    if (binary) {
+        LOG_D("[WS] <<< binary (%u bytes)", static_cast<unsigned>(message.length()));
+    } else {
+        LOG_D("[WS] <<< %s", message.c_str());
+    }
+
+    if (message.length() >= kWsInboundMax) {
+        LOG_W("[WS] message too large; dropped");
+        return;
+    }
+    WsInbound *slot = wsInbound.claim();
+    if (!slot) {
+        LOG_W("[WS] command queue full; dropped");
+        return;
+    }
+    slot->kind = binary ? WsInbound::Kind::Binary : WsInbound::Kind::Text;
+    slot->length = message.length();
+    slot->receivedUs = nowUs();
+    memcpy(slot->data, message.c_str(), message.length());
+    slot->data[message.length()] = '\0';
+    wsInbound.commit();
+    notifyTask(commandTask);
 }
 
 // ----- Command Handling ----------------------------------------------
+// Default movement speed when no explicit speed was ever set.
+// Use the value from config.h (CONFIG_DEFAULT_SPEED) to keep a single
+// configuration point. The config macro is an int literal; cast it.
+constexpr uint8_t DEFAULT_SPEED = uint8_t(CONFIG_DEFAULT_SPEED);
+
+// If payload contains explicit speeds use them. Otherwise, prefer the
+// tank's last user-set speeds (TankSlot leftSpeed/rightSpeed). If those
+// are zero (never set or explicitly zero) fall back to DEFAULT_SPEED so
+// movement commands (forward/back/left/right) actually move the robot
+// without requiring a prior "setspeed" call.
+uint8_t resolveSpeed(bool explicitSpeed, uint8_t requested, uint8_t current) {
+    if (explicitSpeed) {
+        return requested;
+    }
+    return current > 0 ? current : DEFAULT_SPEED;
+}
+
+// Index of a configured tank id, or -1.
+int findTank(const char *id) {
+    for (size_t tank = 0; tank < kTankCount; ++tank) {
+        if (strcmp(kTankConfig[tank].id, id) == 0) {
+            return static_cast<int>(tank);
+        }
+    }
+    return -1;
+}
+
 void handleCommand(const char *json) {
-    StaticJsonDocument<256> doc;
-    DeserializationError err = deserializeJson(doc, json);
+    commandArena.reset();
+    JsonDocument doc(&commandArena);
+    BridgeJson::Inbound msg;
+    DeserializationError err = BridgeJson::parseInbound(doc, json, DEFAULT_SPEED, msg);
     if (err) {
-        Serial.printf("[CMD] JSON parse error: %s\n", err.c_str());
+        LOG_W("[CMD] JSON parse error: %s", err.c_str());
+        return;
+    }
+
+    if (msg.type && strcmp(msg.type, "proto") == 0) {
+        binaryLink = strcmp(msg.proto, BridgeProtocol::kName) == 0;
+        LOG_I("[WS] Bridge protocol: %s", binaryLink ? msg.proto : "json");
+        return;
+    }
+    if (msg.type && strcmp(msg.type, "dump") == 0) {
+        startDump();
         return;
     }
 
-    const char *cmdField = doc["command"];
+    const char *cmdField = msg.command;
     if (!cmdField) {
-        Serial.println("[CMD] Missing command field");
+        LOG_W("[CMD] Missing command field");
+        return;
+    }
+    if (strcmp(cmdField, "estop") == 0) {
+        LOG_W("[CMD] Emergency stop (all tanks)");
+        flight.record(FlightRecorder::Kind::EStop, FlightRecorder::kNoTank);
+        emergencyStop();
         return;
     }
 
-    // Default movement speed when no explicit speed was ever set.
-    // Use the value from config.h (CONFIG_DEFAULT_SPEED) to keep a single
-    // configuration point. The config macro is an int literal; cast it.
-    constexpr uint8_t DEFAULT_SPEED = uint8_t(CONFIG_DEFAULT_SPEED);
+    // Commands without a tankId go to the first tank (single-tank bridges).
+    const int tank = msg.tankId ? findTank(msg.tankId) : 0;
+    if (tank < 0) {
+        LOG_W("[CMD] Unknown tank '%s'; dropped", msg.tankId);
+        return;
+    }
+    const TankSlot &slot = tanks[tank];
 
-    uint8_t left;
-    uint8_t right;
+    uint8_t left = resolveSpeed(msg.hasLeftSpeed, msg.leftSpeed, slot.leftSpeed);
+    uint8_t right = resolveSpeed(msg.hasRightSpeed, msg.rightSpeed, slot.rightSpeed);
 
-    // If payload contains explicit speeds use them. Otherwise, prefer the
-    // last user-set speeds (currentLeftSpeed/currentRightSpeed). If those
-    // are zero (never set or explicitly zero) fall back to DEFAULT_SPEED so
-    // movement commands (forward/back/left/right) actually move the robot
-    // without requiring a prior "setspeed" call.
-    if (doc.containsKey("leftSpeed")) {
-        left = uint8_t(doc["leftSpeed"] | DEFAULT_SPEED);
-    } else if (currentLeftSpeed > 0) {
-        left = currentLeftSpeed;
-    } else {
-        left = DEFAULT_SPEED;
+    TankControl::Command cmd;
+    if (!TankControl::commandFromToken(cmdField, strlen(cmdField), cmd)) {
+        LOG_W("[CMD] Unknown command '%s', sending stop", cmdField);
+        cmd = TankControl::Command::Stop;
     }
+    queueCommand(tank, cmd, left, right, msg.sequence);
+}
 
-    if (doc.containsKey("rightSpeed")) {
-        right = uint8_t(doc["rightSpeed"] | DEFAULT_SPEED);
-    } else if (currentRightSpeed > 0) {
-        right = currentRightSpeed;
-    } else {
-        right = DEFAULT_SPEED;
+void handleBinaryMessage(const uint8_t *data, size_t length) {
+    BridgeProtocol::CommandMessage msg;
+    if (!BridgeProtocol::decode(data, length, msg)) {
+        LOG_W("[CMD] Unknown binary message (%u bytes)", static_cast<unsigned>(length));
+        return;
+    }
+    if (msg.command > static_cast<uint8_t>(TankControl::Command::SetSpeed)) {
+        LOG_W("[CMD] Invalid binary command %u", msg.command);
+        return;
+    }
+    if (msg.flags & BridgeProtocol::kEmergencyStop) {
+        LOG_W("[CMD] Emergency stop (all tanks)");
+        flight.record(FlightRecorder::Kind::EStop, FlightRecorder::kNoTank);
+        emergencyStop();
+        return;
+    }
+
+    if (msg.tank >= kTankCount) {
+        LOG_W("[CMD] Invalid tank index %u", msg.tank);
+        return;
+    }
+
+    const TankSlot &slot = tanks[msg.tank];
+    uint8_t left = resolveSpeed(msg.flags & BridgeProtocol::kHasLeftSpeed,
+                                msg.leftSpeed, slot.leftSpeed);
+    uint8_t right = resolveSpeed(msg.flags & BridgeProtocol::kHasRightSpeed,
+                                 msg.rightSpeed, slot.rightSpeed);
+    queueCommand(msg.tank, static_cast<TankControl::Command>(msg.command), left, right,
+                 msg.sequence);
+}
+
+// Encrypt here, on the command task, so the radio task only moves bytes.
+// A setpoint still waiting for airtime is replaced by this one; Stop is
+// never coalesced away (see CommandMailbox). Each tank has its own radio
+// address and sequence counter, so receivers only see their own frames and
+// their duplicate filter is not confused by the other tanks' traffic.
+bool queueCommand(size_t tank, TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed,
+                  uint16_t hostSequence, bool heartbeat) {
+    TxRequest request;
+    inboundStamps.parsedUs = nowUs();
+    TankControl::ControlFrame frame;
+    TankControl::initFrame(frame, cmd, leftSpeed, rightSpeed, tanks[tank].sequence++,
+                           kTankConfig[tank].address);
+    if (!TankControl::encryptFrame(frame, request.payload, sizeof(request.payload))) {
+        LOG_E("[LoRa] encryptFrame failed");
+        return false;
+    }
+    request.tank = static_cast<uint8_t>(tank);
+    request.command = cmd;
+    request.leftSpeed = leftSpeed;
+    request.rightSpeed = rightSpeed;
+    request.sequence = frame.sequence;
+    request.hostSequence = hostSequence;
+    request.stamps = inboundStamps;
+    request.stamps.postedUs = nowUs();
+    request.heartbeat = heartbeat;
+    request.generation = heartbeat ? tanks[tank].motion.generation() : tanks[tank].motion.queued(cmd);
+    tanks[tank].lastQueuedUs = request.stamps.postedUs;
+    tanks[tank].mailbox.post(request, cmd == TankControl::Command::Stop);
+    if (!heartbeat) {
+        flight.record(FlightRecorder::Kind::Command, request.tank, static_cast<uint8_t>(cmd),
+                      request.sequence, hostSequence, leftSpeed | (rightSpeed << 8));
+    }
+    notifyTask(radioTask);
+    return true;
+}
+
+// Link loss and E-stop: a Stop for every tank. Stops jump any pending
+// setpoints (CommandMailbox) and are served before any tank's setpoint.
+void emergencyStop() {
+    for (size_t tank = 0; tank < kTankCount; ++tank) {
+        queueCommand(tank, TankControl::Command::Stop, 0, 0);
     }
+}
 
-    String normalized = cmdField;
-    normalized.toLowerCase();
+constexpr uint32_t kStopRetryMs = 100;
 
-    TankControl::Command cmd = mapCommand(normalized);
-    if (!transmitLoRa(cmd, left, right)) {
-        Serial.println("[LoRa] Transmission failed");
+// Keeps a moving receiver's link watchdog fed: repeats the tank's current
+// motion when nothing was queued for it within kHeartbeatIntervalMs, so a
+// tank streaming setpoints never needs one. Heartbeats go in as setpoints,
+// so any real command supersedes one still waiting, and the scheduler
+// serves Stops first; their airtime is counted per tank.
+// A tank whose Stop failed gets no heartbeats (TankMotion) and the Stop
+// again, kStopRetryMs after the last try, until one goes on air.
+void queueHeartbeats() {
+    const uint64_t now = nowUs();
+    for (size_t i = 0; i < kTankCount; ++i) {
+        const TankSlot &tank = tanks[i];
+        if (tank.mailbox.pending()) {
+            continue;
+        }
+        if (tank.motion.stopRetryDue()) {
+            if (now - tank.lastQueuedUs >= kStopRetryMs * 1000ULL) {
+                inboundStamps = CommandStamps{};
+                inboundStamps.receivedUs = inboundStamps.dequeuedUs = now;
+                queueCommand(i, TankControl::Command::Stop, 0, 0);
+            }
+            continue;
+        }
+        if (!tank.motion.heartbeatDue() ||
+            now - tank.lastQueuedUs < TankControl::kHeartbeatIntervalMs * 1000ULL) {
+            continue;
+        }
+        inboundStamps = CommandStamps{};
+        inboundStamps.receivedUs = inboundStamps.dequeuedUs = now;
+        queueCommand(i, tank.motion.motion(), tank.motion.left(), tank.motion.right(), 0,
+                     /*heartbeat=*/true);
+    }
+}
+
+uint32_t gatewayUs(const CommandStamps &stamps) {
+    return static_cast<uint32_t>(stamps.txDoneUs - stamps.receivedUs);
+}
+
+void recordLatency(const CommandStamps &stamps) {
+    latency[kStageQueue].record(static_cast<uint32_t>(stamps.dequeuedUs - stamps.receivedUs));
+    latency[kStageParse].record(static_cast<uint32_t>(stamps.parsedUs - stamps.dequeuedUs));
+    latency[kStageEncrypt].record(static_cast<uint32_t>(stamps.postedUs - stamps.parsedUs));
+    latency[kStageRadio].record(static_cast<uint32_t>(stamps.txDoneUs - stamps.postedUs));
+    latency[kStageTotal].record(gatewayUs(stamps));
+}
+
+void recordStopLatency(const CommandStamps &stamps) {
+    stopToAir.record(static_cast<uint32_t>(stamps.onAirUs - stamps.receivedUs));
+}
+
+void publishJsonAck(const TxResult &result) {
+    WsOutbound *slot = statusOut.claim();
+    if (!slot) {
         return;
     }
+    const BridgeJson::Ack ack{kTankConfig[result.tank].id, stateName(result.command),
+                              result.hostSequence, result.sequence, result.leftSpeed,
+                              result.rightSpeed, gatewayUs(result.stamps)};
+    const size_t length = BridgeJson::writeAck(ack, slot->data, sizeof(slot->data));
+    if (length == 0) {
+        return;
+    }
+    slot->binary = false;
+    slot->length = length;
+    statusOut.commit();
+}
 
-    if (normalized == "setspeed") {
-        currentLeftSpeed = left;
-        currentRightSpeed = right;
-    } else if (normalized == "stop") {
-        currentLeftSpeed = currentRightSpeed = 0;
+void applyTxResult(const TxResult &result) {
+    TankSlot &tank = tanks[result.tank];
+    tank.motion.result(result.generation, result.command, result.leftSpeed, result.rightSpeed,
+                       result.ok);
+    if (result.heartbeat) {
+        if (!result.ok && !result.preempted) {
+            LOG_W("[LoRa] tank=%u heartbeat failed", result.tank);
+        }
+        return;  // not a bridge command: no ack, latency or flight record
+    }
+    if (result.preempted) {
+        ++setpointsPreempted;  // never on air; the bridge treats it as superseded
+        flight.record(FlightRecorder::Kind::Preempted, result.tank,
+                      static_cast<uint8_t>(result.command), result.sequence, result.hostSequence);
+        return;
+    }
+    if (!result.ok) {
+        LOG_E("[LoRa] Transmission failed");
+        flight.record(FlightRecorder::Kind::TxFailed, result.tank,
+                      static_cast<uint8_t>(result.command), result.sequence, result.hostSequence);
+        return;
     }
-    currentState = normalized;
+    flight.record(FlightRecorder::Kind::TxDone, result.tank, static_cast<uint8_t>(result.command),
+                  result.sequence, result.hostSequence, gatewayUs(result.stamps));
 
-    publishStatus(true);
+    if (result.command == TankControl::Command::SetSpeed) {
+        tank.leftSpeed = result.leftSpeed;
+        tank.rightSpeed = result.rightSpeed;
+    } else if (result.command == TankControl::Command::Stop) {
+        tank.leftSpeed = tank.rightSpeed = 0;
+    }
+    tank.command = result.command;
+    recordLatency(result.stamps);
+    if (result.command == TankControl::Command::Stop) {
+        recordStopLatency(result.stamps);
+    }
+
+    // The ack carries the tank's state and speeds, so they need no delta.
+
+    if (!binaryLink) {
+        publishJsonAck(result);
+        return;
+    }
+
+    BridgeProtocol::AckMessage ack{};
+    ack.tank = result.tank;
+    ack.command = static_cast<uint8_t>(result.command);
+    ack.leftSpeed = result.leftSpeed;
+    ack.rightSpeed = result.rightSpeed;
+    ack.sequence = result.hostSequence;
+    ack.radioSequence = result.sequence;
+    ack.flags = BridgeProtocol::kAckTransmitted;
+    ack.gatewayUs = gatewayUs(result.stamps);
+    if (WsOutbound *slot = statusOut.claim()) {
+        slot->binary = true;
+        slot->length = BridgeProtocol::encode(ack, reinterpret_cast<uint8_t *>(slot->data),
+                                              sizeof(slot->data));
+        statusOut.commit();
+    }
+}
+
+const char *stateName(TankControl::Command cmd) {
+    switch (cmd) {
+        case TankControl::Command::Forward: return "forward";
+        case TankControl::Command::Backward: return "backward";
+        case TankControl::Command::Left: return "left";
+        case TankControl::Command::Right: return "right";
+        case TankControl::Command::SetSpeed: return "setspeed";
+        default: return "stop";
+    }
+}
+
+TxResult transmitLoRa(const TxRequest &request) {
+    // After a short idle the receiver may have fallen back to the rendezvous
+    // channel, and after a long one it may be parked on a CAD duty cycle
+    // there; re-announce the data channel first, with a preamble that spans
+    // one CAD period when needed.
+    // Idle time is per tank: each receiver falls back on its own.
+    TankSlot &tank = tanks[request.tank];
+    const uint32_t idleMs = millis() - tank.lastTxAt;
+    // While frames keep flowing the idle rule never fires, so the announce
+    // also repeats every kAnnounceRepeatMs for receivers that lost the channel.
+    const bool announce = tank.lastTxAt == 0 || idleMs >= TankControl::kAnnounceAfterIdleMs ||
+                          millis() - lastAnnounceAt >= TankControl::kAnnounceRepeatMs;
+    const bool wake = tank.lastTxAt == 0 || idleMs >= TankControl::kWakeAfterIdleMs;
+    const uint64_t startedUs = nowUs();
+    TxResult result{request.tank, request.command, request.leftSpeed, request.rightSpeed,
+                    request.sequence, request.hostSequence, request.stamps, false, false,
+                    request.heartbeat, request.generation};
+    if (announce) {
+        announceChannel(wake);
+        // A wake announce is ~0.3 s of airtime; a Stop that arrived meanwhile
+        // goes next instead of this setpoint. The setpoint returns to its
+        // mailbox unless that Stop (or a newer setpoint) made it stale.
+        if (request.command != TankControl::Command::Stop && stopPendingAnyTank()) {
+            tank.airtimeUs += nowUs() - startedUs;
+            tank.lastTxAt = millis();  // the announce reached the receiver
+            tank.mailbox.putBack(request);
+            result.preempted = true;
+            LOG_D("[LoRa] tank=%u setpoint preempted by a Stop", request.tank);
+            return result;
+        }
+    }
+
+    result.stamps.onAirUs = nowUs();
+    result.ok = sendLoRaPacket(request.payload, sizeof(request.payload),
+                               TankControl::kLinkPreambleSymbols);
+    const uint64_t doneUs = nowUs();
+    tank.airtimeUs += doneUs - startedUs;
+    if (request.heartbeat) {
+        ++tank.heartbeats;
+        tank.heartbeatAirtimeUs += doneUs - startedUs;
+    }
+    if (result.ok) {
+        result.stamps.txDoneUs = doneUs;
+        tank.lastTxAt = millis();
+        ++tank.frames;
+        LOG_D("[LoRa] >>> tank=%u cmd=%d seq=%u L=%u R=%u",
+              request.tank, static_cast<int>(request.command),
+              request.sequence,
+              request.leftSpeed,
+              request.rightSpeed);
+    }
+    return result;
 }
 
-TankControl::Command mapCommand(const String &cmd) {
-    if (cmd == "forward") return TankControl::Command::Forward;
-    if (cmd == "backward") return TankControl::Command::Backward;
-    if (cmd == "left") return TankControl::Command::Left;
-    if (cmd == "right") return TankControl::Command::Right;
-    if (cmd == "setspeed") return TankControl::Command::SetSpeed;
-    return TankControl::Command::Stop;
+bool sendLoRaPacket(const uint8_t *buffer, size_t length, long preambleSymbols) {
+    return radio.transmitControl(buffer, length, preambleSymbols, TankControl::kImplicitHeader);
 }
 
-bool transmitLoRa(TankControl::Command cmd, uint8_t leftSpeed, uint8_t rightSpeed) {
+// ----- Channel Selection ---------------------------------------------
+void selectChannel() {
+    dataChannel = ChannelScan::scan(TankControl::kChannelPlanMHz, TankControl::kChannelCount,
+                                    CHANNEL_SCAN_WINDOW_MS, channelScan);
+    AsyncLog::flush();  // the scan report goes straight to Serial
+    ChannelScan::print(Serial, channelScan);
+    LOG_I("[LoRa] Data channel %u (%.1f MHz), rendezvous %.1f MHz",
+          dataChannel, TankControl::kChannelPlanMHz[dataChannel],
+          TankControl::kRendezvousMHz);
+
+    const RadioProfile control{TankControl::kChannelPlanMHz[dataChannel], 7,
+                               static_cast<uint32_t>(CONFIG_RADIO_BW * 1000), 5, 0x12,
+                               TankControl::kLinkPreambleSymbols};
+#if ENABLE_SENSOR_RX
+    const RadioProfile sensor{SENSOR_RADIO_FREQ_MHZ, SENSOR_RADIO_SF,
+                              static_cast<uint32_t>(CONFIG_RADIO_BW * 1000), SENSOR_RADIO_CR,
+                              SENSOR_SYNC_WORD, 8};
+    radio.begin(control, &sensor, RADIO_CS_PIN);
+    LOG_I("[RADIO] Shared radio: control %.1f MHz SF7 / sensor %.1f MHz SF%d",
+          control.frequencyMHz, sensor.frequencyMHz, SENSOR_RADIO_SF);
+#else
+    radio.begin(control, nullptr, RADIO_CS_PIN);
+#endif
+    announceChannel(false);
+}
+
+bool announceChannel(bool wake) {
     TankControl::ControlFrame frame;
-    TankControl::initFrame(frame, cmd, leftSpeed, rightSpeed, sequenceCounter++);
+    // Broadcast: every tank on this gateway follows the same data channel.
+    // Receivers skip the duplicate filter for channel frames, so the
+    // gateway-wide announce sequence cannot collide with a tank's own.
+    TankControl::initFrame(frame, TankControl::Command::Channel, dataChannel, 0,
+                           announceSequence++);
 
     uint8_t buffer[TankControl::kFrameSize];
     if (!TankControl::encryptFrame(frame, buffer, sizeof(buffer))) {
-        Serial.println("[LoRa] encryptFrame failed");
+        LOG_E("[LoRa] encryptFrame failed");
         return false;
     }
 
-    LoRa.idle();
-    LoRa.beginPacket();
-    LoRa.write(buffer, sizeof(buffer));
-    bool ok = LoRa.endPacket() == 1;
-    LoRa.receive();
-
+    radio.setControlFrequency(TankControl::kRendezvousMHz);
+    bool ok = sendLoRaPacket(buffer, sizeof(buffer),
+                             wake ? TankControl::kWakePreambleSymbols
+                                  : TankControl::kLinkPreambleSymbols);
+    radio.setControlFrequency(TankControl::kChannelPlanMHz[dataChannel]);
+    delay(TankControl::kAnnounceGuardMs);
     if (ok) {
-        Serial.printf("[LoRa] >>> cmd=%d seq=%u L=%u R=%u\n",
-                      static_cast<int>(frame.command),
-                      frame.sequence,
-                      frame.leftSpeed,
-                      frame.rightSpeed);
+        lastAnnounceAt = millis();
     }
+
+    LOG_I("[LoRa] >>> channel announce ch=%u seq=%u%s%s",
+          dataChannel, frame.sequence,
+          wake ? " (wake preamble)" : "", ok ? "" : " FAILED");
     return ok;
 }
 
+// ----- Sensor Forwarding ---------------------------------------------
+void forwardSensorPacket(const LoRaRx::Packet &packet) {
+    LOG_D("[SENSOR] <<< %u bytes RSSI=%d SNR=%.1f",
+          static_cast<unsigned>(packet.length), packet.rssi, packet.snr);
+    if (!wsConnected) {
+        return;
+    }
+    WsOutbound *slot = sensorOut.claim();
+    if (!slot) {
+        return;
+    }
+
+    radioArena.reset();
+    JsonDocument doc(&radioArena);
+    const BridgeJson::Sensor sensor{kTankConfig[0].id, packet.rssi, packet.snr,
+                                    packet.frequencyError, packet.receivedAtMs, packet.c_str()};
+    const size_t length = BridgeJson::writeSensor(doc, sensor, slot->data, sizeof(slot->data));
+    if (length == 0) {
+        return;  // truncated; slot is not committed
+    }
+    slot->binary = false;
+    slot->length = length;
+    sensorOut.commit();
+}
+
 // ----- Status Reporting ----------------------------------------------
-bool publishStatus(bool force) {
-    if (!wsConnected || !wsClient.available()) {
+// Worst-case JSON size of each snapshot part, every number at its widest,
+// so a new field cannot push a part past its outbound slot unnoticed.
+// jsonField: "key":value and a separator.
+constexpr size_t kJsonU32 = 10;
+constexpr size_t kJsonFloat = 16;              // 9 digits, sign, point, exponent
+constexpr size_t kJsonBraces = 2;
+constexpr size_t jsonString(size_t length) { return length + 2; }
+constexpr size_t jsonField(const char *key, size_t valueMax) {
+    return literalLength(key) + 4 + valueMax;
+}
+constexpr size_t jsonHeader(const char *type) {
+    return kJsonBraces + jsonField("type", jsonString(literalLength(type))) +
+           jsonField("tankId", jsonString(kMaxTankIdLength));
+}
+constexpr size_t kSnapshotTankMax =
+    jsonHeader("status") + jsonField("state", jsonString(8)) + jsonField("leftSpeed", 3) +
+    jsonField("rightSpeed", 3) + jsonField("addr", 3) + jsonField("frames", kJsonU32) +
+    jsonField("airMs", kJsonU32) + jsonField("heartbeats", kJsonU32) +
+    jsonField("hbAirMs", kJsonU32) + jsonField("superseded", kJsonU32) +
+    jsonField("wifiRssi", 4) + jsonField("uptime", kJsonU32) + jsonField("freeHeap", kJsonU32);
+constexpr size_t kSnapshotLinkMax =
+    jsonHeader("link") + jsonField("wifi", jsonString(8)) + jsonField("joins", kJsonU32) +
+    jsonField("fastJoins", kJsonU32) + jsonField("joinFailures", kJsonU32) +
+    jsonField("drops", kJsonU32) + jsonField("lastJoinMs", kJsonU32) +
+    jsonField("avgJoinMs", kJsonU32) + jsonField("maxJoinMs", kJsonU32) +
+    jsonField("wsConnects", kJsonU32) + jsonField("wsFailures", kJsonU32) +
+    jsonField("wsLastConnectMs", kJsonU32) +
+    jsonField("ping", kJsonBraces + jsonField("rttUs", kJsonU32) + jsonField("rttMinUs", kJsonU32) +
+                          jsonField("rttMaxUs", kJsonU32) + jsonField("sent", kJsonU32) +
+                          jsonField("missed", kJsonU32) + jsonField("deadLinks", kJsonU32) +
+                          jsonField("lastDetectMs", kJsonU32)) +
+    jsonField("tls", kJsonBraces + jsonField("handshakes", kJsonU32) +
+                         jsonField("resumed", kJsonU32) + jsonField("failures", kJsonU32) +
+                         jsonField("lastMs", kJsonU32) + jsonField("lastResumed", 5) +
+                         jsonField("tcpMs", kJsonU32) + jsonField("fullAvgMs", kJsonU32) +
+                         jsonField("resumedAvgMs", kJsonU32));
+constexpr size_t jsonTask(const char *name) {
+    return jsonField(name, kJsonBraces + jsonField("awake", kJsonFloat) + jsonField("wakeups", kJsonU32));
+}
+constexpr size_t jsonQueue(const char *name) { return jsonField(name, 2 + 3 * (kJsonU32 + 1)); }
+constexpr size_t kSnapshotRadioMax =
+    jsonHeader("radio") + jsonField("channel", 3) + jsonField("freqMHz", kJsonFloat) +
+    jsonField("scanAvgRssi", 2 + TankControl::kChannelCount * 5) +
+    jsonField("controlUtil", kJsonFloat) + jsonField("sensorUtil", kJsonFloat) +
+    jsonField("sensorRx", kJsonU32) + jsonField("sensorPreempted", kJsonU32) +
+    jsonField("switchMaxUs", kJsonU32) + jsonField("switchAvgUs", kJsonU32) +
+    jsonField("tasks", kJsonBraces + jsonTask("net") + jsonTask("cmd") + jsonTask("radio")) +
+    jsonField("queues", kJsonBraces + jsonQueue("wsIn") + jsonQueue("txResult") +
+                            jsonQueue("statusOut") + jsonQueue("sensorOut")) +
+    jsonField("mailbox", kJsonBraces + jsonField("posted", kJsonU32) +
+                             jsonField("superseded", kJsonU32) + jsonField("stops", kJsonU32) +
+                             jsonField("preempted", kJsonU32)) +
+    jsonField("jsonArena", kJsonBraces + jsonField("cmdPeak", kJsonU32) +
+                               jsonField("radioPeak", kJsonU32) + jsonField("overflows", kJsonU32));
+constexpr size_t jsonStage(const char *name) {
+    return jsonField(name, kJsonBraces + jsonField("p50", kJsonU32) + jsonField("p99", kJsonU32) +
+                               jsonField("max", kJsonU32) + jsonField("n", kJsonU32));
+}
+constexpr size_t kSnapshotLatencyMax =
+    jsonHeader("latency") +
+    jsonField("latencyUs", kJsonBraces + jsonStage("queue") + jsonStage("parse") +
+                               jsonStage("encrypt") + jsonStage("radio") + jsonStage("total") +
+                               jsonStage("stopToAir"));
+static_assert(kSnapshotTankMax < kWsOutboundMax && kSnapshotLinkMax < kWsOutboundMax &&
+                  kSnapshotRadioMax < kWsOutboundMax && kSnapshotLatencyMax < kWsOutboundMax,
+              "a status snapshot part can outgrow its WsOutbound slot");
+
+void addTaskMetrics(JsonObject tasks, const TaskMetrics &task, uint64_t elapsedUs) {
+    JsonObject entry = tasks.createNestedObject(task.name);
+    entry["awake"] = elapsedUs ? 100.0f * task.awakeUs.load() / elapsedUs : 0.0f;
+    entry["wakeups"] = task.wakeups.load();
+}
+
+template <typename Ring>
+void addQueueMetrics(JsonObject queues, const char *name, const Ring &ring) {
+    JsonArray entry = queues.createNestedArray(name);
+    entry.add(ring.size());
+    entry.add(ring.highWater());
+    entry.add(ring.dropped());
+}
+
+uint32_t supersededTotal() {
+    uint32_t total = 0;
+    for (const TankSlot &tank : tanks) {
+        total += tank.mailbox.superseded();
+    }
+    return total;
+}
+
+// One message per tank; returns false if the outbound ring filled up.
+bool publishBinaryStatus(uint32_t now) {
+    for (size_t i = 0; i < kTankCount; ++i) {
+        WsOutbound *slot = statusOut.claim();
+        if (!slot) {
+            return false;
+        }
+        const TankSlot &tank = tanks[i];
+        BridgeProtocol::StatusMessage status{};
+        status.state = static_cast<uint8_t>(tank.command);
+        status.leftSpeed = tank.leftSpeed;
+        status.rightSpeed = tank.rightSpeed;
+        status.wifiRssi = static_cast<int8_t>(WiFi.RSSI());
+        status.channel = dataChannel;
+        status.tank = static_cast<uint8_t>(i);
+        status.uptimeS = now / 1000;
+        status.freeHeap = ESP.getFreeHeap();
+        status.superseded = tank.mailbox.superseded();
+        slot->binary = true;
+        slot->length = BridgeProtocol::encode(status, reinterpret_cast<uint8_t *>(slot->data),
+                                              sizeof(slot->data));
+        statusOut.commit();
+    }
+    return true;
+}
+
+// Sample the delta fields; returns true when any of them is due.
+bool sampleDeltaFields(uint32_t now) {
+    const int8_t rssi = WiFi.RSSI();
+    const uint32_t freeHeap = ESP.getFreeHeap();
+    bool any = false;
+    any |= statusDelta.update(kDeltaWifiRssi, rssi, now);
+    any |= statusDelta.update(kDeltaFreeHeap, freeHeap, now);
+    any |= statusDelta.update(kDeltaSuperseded, supersededTotal(), now);
+    if (any) {
+        flight.record(FlightRecorder::Kind::Status, FlightRecorder::kNoTank, 0,
+                      static_cast<uint8_t>(rssi), 0, freeHeap);
+    }
+    return any;
+}
+
+bool publishDelta(uint32_t now) {
+    if (binaryLink) {
+        // The binary status is already smaller than a JSON delta.
+        statusDelta.commitAll(now);
+        return publishBinaryStatus(now);
+    }
+
+    WsOutbound *slot = statusOut.claim();
+    if (!slot) {
         return false;
     }
+    BridgeJson::Delta delta{};
+    delta.tankId = kTankConfig[0].id;
+    delta.hasWifiRssi = statusDelta.due(kDeltaWifiRssi);
+    delta.wifiRssi = WiFi.RSSI();
+    delta.hasFreeHeap = statusDelta.due(kDeltaFreeHeap);
+    delta.freeHeap = ESP.getFreeHeap();
+    delta.hasSuperseded = statusDelta.due(kDeltaSuperseded);
+    delta.superseded = supersededTotal();
+    for (size_t i = 0; i < kDeltaCount; ++i) {
+        if (statusDelta.due(i)) {
+            statusDelta.commit(i, now);
+        }
+    }
 
-    uint32_t now = millis();
-    if (!force && (now - lastStatusAt) < kStatusIntervalMs) {
+    commandArena.reset();
+    JsonDocument doc(&commandArena);
+    const size_t length = BridgeJson::writeDelta(doc, delta, slot->data, sizeof(slot->data));
+    if (length == 0) {
         return false;
     }
-    lastStatusAt = now;
+    slot->binary = false;
+    slot->length = length;
+    statusOut.commit();
+    return true;
+}
 
-    StaticJsonDocument<256> doc;
+// Snapshot parts, built into doc. Parts other than the per-tank statuses
+// go to the first tank's clients, as the single snapshot used to.
+void buildTankStatus(JsonDocument &doc, size_t i, uint32_t now) {
+    const TankSlot &tank = tanks[i];
     doc["type"] = "status";
-    doc["tankId"] = TANK_ID;
-    doc["state"] = currentState;
-    doc["leftSpeed"] = currentLeftSpeed;
-    doc["rightSpeed"] = currentRightSpeed;
+    doc["tankId"] = kTankConfig[i].id;
+    doc["state"] = stateName(tank.command);
+    doc["leftSpeed"] = tank.leftSpeed;
+    doc["rightSpeed"] = tank.rightSpeed;
+    doc["addr"] = kTankConfig[i].address;
+    doc["frames"] = tank.frames;
+    doc["airMs"] = static_cast<uint32_t>(tank.airtimeUs / 1000);
+    doc["heartbeats"] = tank.heartbeats;
+    doc["hbAirMs"] = static_cast<uint32_t>(tank.heartbeatAirtimeUs / 1000);
+    doc["superseded"] = tank.mailbox.superseded();
     doc["wifiRssi"] = WiFi.RSSI();
     doc["uptime"] = now / 1000;
     doc["freeHeap"] = ESP.getFreeHeap();
+}
+
+void buildLinkStatus(JsonDocument &doc) {
+    const WifiLink::Stats &wifiStats = wifiLink.stats();
+    doc["type"] = "link";
+    doc["tankId"] = kTankConfig[0].id;
+    doc["wifi"] = wifiLink.stateName();
+    doc["joins"] = wifiStats.joins;
+    doc["fastJoins"] = wifiStats.fastJoins;
+    doc["joinFailures"] = wifiStats.failures;
+    doc["drops"] = wifiStats.drops;
+    doc["lastJoinMs"] = wifiStats.lastJoinMs;
+    doc["avgJoinMs"] = wifiLink.avgJoinMs();
+    doc["maxJoinMs"] = wifiStats.maxJoinMs;
+    doc["wsConnects"] = wsConnects;
+    doc["wsFailures"] = wsFailures;
+    doc["wsLastConnectMs"] = wsLastConnectMs;
+    const WsHeartbeat::Stats &beat = wsHeartbeat.stats();
+    JsonObject ping = doc.createNestedObject("ping");
+    ping["rttUs"] = beat.rttUs;
+    ping["rttMinUs"] = beat.rttMinUs;
+    ping["rttMaxUs"] = beat.rttMaxUs;
+    ping["sent"] = beat.pings;
+    ping["missed"] = beat.missed;
+    ping["deadLinks"] = beat.deadLinks;
+    ping["lastDetectMs"] = beat.lastDetectMs;
+#if WS_USE_TLS
+    const TlsSessionClient::Stats &tlsStats = wsTls->stats();
+    JsonObject tls = doc.createNestedObject("tls");
+    tls["handshakes"] = tlsStats.handshakes;
+    tls["resumed"] = tlsStats.resumed;
+    tls["failures"] = tlsStats.failures;
+    tls["lastMs"] = tlsStats.lastHandshakeMs;
+    tls["lastResumed"] = tlsStats.lastResumed;
+    tls["tcpMs"] = tlsStats.lastTcpMs;
+    tls["fullAvgMs"] = wsTls->avgFullMs();
+    tls["resumedAvgMs"] = wsTls->avgResumedMs();
+#endif
+}
+
+void buildRadioStatus(JsonDocument &doc) {
+    doc["type"] = "radio";
+    doc["tankId"] = kTankConfig[0].id;
+    doc["channel"] = dataChannel;
+    doc["freqMHz"] = TankControl::kChannelPlanMHz[dataChannel];
+    JsonArray scan = doc.createNestedArray("scanAvgRssi");
+    for (size_t i = 0; i < channelScan.count; ++i) {
+        scan.add(static_cast<int>(channelScan.channels[i].averageRssi));
+    }
+    if (radio.sharesRadio()) {
+        doc["controlUtil"] = radio.utilisation(RadioScheduler::Slot::Control);
+        doc["sensorUtil"] = radio.utilisation(RadioScheduler::Slot::Sensor);
+        doc["sensorRx"] = radio.stats(RadioScheduler::Slot::Sensor).packets;
+        doc["sensorPreempted"] = radio.sensorPreemptions();
+        doc["switchMaxUs"] = radio.maxSwitchUs();
+        doc["switchAvgUs"] = radio.avgSwitchUs();
+    }
+
+    // Per-task share of wall time awake and [depth, high-water, dropped] per
+    // queue.
+    const uint64_t elapsedUs = nowUs() - tasksStartedUs;
+    JsonObject tasks = doc.createNestedObject("tasks");
+    addTaskMetrics(tasks, networkTask, elapsedUs);
+    addTaskMetrics(tasks, commandTask, elapsedUs);
+    addTaskMetrics(tasks, radioTask, elapsedUs);
+    JsonObject queues = doc.createNestedObject("queues");
+    addQueueMetrics(queues, "wsIn", wsInbound);
+    addQueueMetrics(queues, "txResult", txResults);
+    addQueueMetrics(queues, "statusOut", statusOut);
+    addQueueMetrics(queues, "sensorOut", sensorOut);
+    JsonObject mailbox = doc.createNestedObject("mailbox");
+    uint32_t posted = 0;
+    uint32_t stops = 0;
+    for (const TankSlot &tank : tanks) {
+        posted += tank.mailbox.posted();
+        stops += tank.mailbox.stops();
+    }
+    mailbox["posted"] = posted;
+    mailbox["superseded"] = supersededTotal();
+    mailbox["stops"] = stops;
+    mailbox["preempted"] = setpointsPreempted;
+    JsonObject arena = doc.createNestedObject("jsonArena");
+    arena["cmdPeak"] = commandArena.peak();
+    arena["radioPeak"] = radioArena.peak();
+    arena["overflows"] = commandArena.overflows() + radioArena.overflows();
+}
+
+void addLatencyStage(JsonObject stages, const char *name, const LatencyHistogram &histogram) {
+    JsonObject stage = stages.createNestedObject(name);
+    stage["p50"] = histogram.percentileUs(50);
+    stage["p99"] = histogram.percentileUs(99);
+    stage["max"] = histogram.maxUs();
+    stage["n"] = histogram.count();
+}
+
+void buildLatencyStatus(JsonDocument &doc) {
+    doc["type"] = "latency";
+    doc["tankId"] = kTankConfig[0].id;
+    JsonObject stages = doc.createNestedObject("latencyUs");
+    for (size_t i = 0; i < kStageCount; ++i) {
+        addLatencyStage(stages, kStageNames[i], latency[i]);
+    }
+    addLatencyStage(stages, "stopToAir", stopToAir);
+}
+
+// Sends the snapshot parts still due, one outbound slot each; returns false
+// when the ring fills up, and the next pass carries on from there.
+bool continueSnapshot(uint32_t now) {
+    while (snapshotNext < kSnapshotParts) {
+        WsOutbound *slot = statusOut.claim();
+        if (!slot) {
+            return false;
+        }
+        commandArena.reset();
+        JsonDocument doc(&commandArena);
+        switch (snapshotNext) {
+            case kPartLink: buildLinkStatus(doc); break;
+            case kPartRadio: buildRadioStatus(doc); break;
+            case kPartLatency: buildLatencyStatus(doc); break;
+            default: buildTankStatus(doc, snapshotNext, now); break;
+        }
+        ++snapshotNext;
+        const size_t length = BridgeJson::serialize(doc, slot->data, sizeof(slot->data));
+        if (length == 0) {
+            // Cannot happen within the kSnapshot*Max bounds below.
+            LOG_E("[STATUS] snapshot part %u too large for outbound slot",
+                  static_cast<unsigned>(snapshotNext - 1));
+            continue;
+        }
+        slot->binary = false;
+        slot->length = length;
+        LOG_D("[STATUS] %s (queued)", slot->data);
+        statusOut.commit();
+    }
+    return true;
+}
+
+// force: full snapshot now (bridge just connected). A snapshot that does
+// not fit the outbound ring at once is finished on later passes.
+bool publishStatus(bool force) {
+    if (!wsConnected) {
+        snapshotNext = kSnapshotParts;  // the reconnect asks for a new one
+        return false;
+    }
+
+    uint32_t now = millis();
+    if (force) {
+        statusDelta.invalidate();
+    }
+    if (force || now - lastSnapshotAt >= kSnapshotIntervalMs) {
+        lastSnapshotAt = now;
+        sampleDeltaFields(now);
+        statusDelta.commitAll(now);
+        snapshotNext = 0;
+    }
+    if (snapshotNext < kSnapshotParts) {
+        return continueSnapshot(now);
+    }
+    if (now - lastDeltaCheckAt < kDeltaCheckMs) {
+        return false;
+    }
+    lastDeltaCheckAt = now;
+    return sampleDeltaFields(now) && publishDelta(now);
+}
 
-    String out;
-    serializeJson(doc, out);
-    bool sent = wsClient.send(out);
-    Serial.printf("[STATUS] %s (%s)\n", out.c_str(), sent ? "sent" : "failed");
-    return sent;
+// ----- Flight Recorder Dump ------------------------------------------
+// Snapshot of the records held when the request arrived, sent a few
+// chunks per command-task pass so acks and status keep flowing. Records
+// overwritten while the dump runs show up as a gap in firstIndex.
+void startDump() {
+    dumpNext = flight.tail();
+    dumpEnd = flight.head();
+    dumpNowUs = nowUs();
+    dumpFirst = true;
+    dumpActive = true;
+    LOG_I("[FLIGHT] Dump of %lu records requested",
+          static_cast<unsigned long>(dumpEnd - dumpNext));
+}
+
+void continueDump() {
+    constexpr size_t kHeaderSize = sizeof(BridgeProtocol::DumpHeader);
+    constexpr size_t kRecordsPerChunk = (kWsOutboundMax - kHeaderSize) / sizeof(FlightRecorder::Record);
+    while (dumpActive) {
+        if (!wsConnected) {
+            dumpActive = false;  // the bridge asks again after reconnecting
+            return;
+        }
+        WsOutbound *slot = statusOut.claim();
+        if (!slot) {
+            return;
+        }
+        auto *records = reinterpret_cast<FlightRecorder::Record *>(slot->data + kHeaderSize);
+        const size_t count = flight.copy(&dumpNext, dumpEnd, records, kRecordsPerChunk);
+
+        BridgeProtocol::DumpHeader header{};
+        header.flags = dumpFirst ? BridgeProtocol::kDumpFirst : 0;
+        if (dumpNext >= dumpEnd) {
+            header.flags |= BridgeProtocol::kDumpLast;
+            dumpActive = false;
+        }
+        header.count = static_cast<uint16_t>(count);
+        header.firstIndex = dumpNext - count;
+        header.nowUs = dumpNowUs;
+        BridgeProtocol::encode(header, reinterpret_cast<uint8_t *>(slot->data), kHeaderSize);
+        dumpFirst = false;
+
+        slot->binary = true;
+        slot->length = kHeaderSize + count * sizeof(FlightRecorder::Record);
+        statusOut.commit();
+    }
 }
 
 // ----- LoRa -----------------------------------------------------------
 bool setupLoRa() {
     SPI.begin(RADIO_SCLK_PIN, RADIO_MISO_PIN, RADIO_MOSI_PIN, RADIO_CS_PIN);
     LoRa.setPins(RADIO_CS_PIN, RADIO_RST_PIN, RADIO_DIO0_PIN);
+    LoRaRx::configureSpi();
 
 #ifdef RADIO_TCXO_ENABLE
     pinMode(RADIO_TCXO_ENABLE, OUTPUT);
@@ -315,7 +1510,7 @@ bool setupLoRa() {
 #endif
 
     if (!LoRa.begin(CONFIG_RADIO_FREQ * 1000000)) {
-        Serial.println("[LoRa] begin() failed");
+        LOG_E("[LoRa] begin() failed");
         return false;
     }
 
@@ -324,8 +1519,11 @@ bool setupLoRa() {
     LoRa.setSpreadingFactor(7);
     LoRa.setCodingRate4(5);
     LoRa.enableCrc();
+    LoRa.setPreambleLength(TankControl::kLinkPreambleSymbols);
     LoRa.receive();
 
-    Serial.println("[LoRa] Radio ready");
+    LOG_I("[LoRa] Radio ready");
+    AsyncLog::flush();
+    TankControl::printLinkProfile(Serial, 7, CONFIG_RADIO_BW * 1000, 5);
     return true;
 }
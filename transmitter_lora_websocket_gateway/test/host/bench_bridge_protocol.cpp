@@ -0,0 +1,160 @@
+// Host benchmark: bin1 (BridgeProtocol.h) against the JSON text it replaces
+// on the gateway <-> bridge WebSocket hop, for the gateway's side of it:
+// decoding a command, encoding its ack and encoding a status update. Both
+// columns run the code main.cpp runs: BridgeJson.h on a JsonArena, and
+// BridgeProtocol encode/decode. Run with `make bench` (see Makefile).
+//
+// Host figures only rank the two paths; the ESP32 is roughly an order of
+// magnitude slower across the board.
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cstdio>
+#include "BridgeJson.h"
+#include "BridgeProtocol.h"
+#include "ControlProtocol.h"
+#include "JsonArena.h"
+
+namespace {
+
+constexpr long kIterations = 200000;
+constexpr char kTankId[] = "tank_001";
+constexpr uint8_t kDefaultSpeed = 150;
+
+volatile uint32_t sink;  // keeps every result observable
+JsonArena<4096> arena;   // as commandArena
+char outbound[1024];     // as WsOutbound::data
+
+template <typename Body>
+double nsPerOp(Body body) {
+  for (long i = 0; i < kIterations / 10; ++i) {
+    body(i);  // warm-up
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < kIterations; ++i) {
+    body(i);
+  }
+  const std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / kIterations;
+}
+
+void report(const char *name, double jsonNs, size_t jsonBytes, double binNs, size_t binBytes) {
+  std::printf("%-15s json %8.1f ns %4u B | bin1 %6.1f ns %3u B | json/bin1 %5.1fx\n", name,
+              jsonNs, static_cast<unsigned>(jsonBytes), binNs, static_cast<unsigned>(binBytes),
+              jsonNs / binNs);
+}
+
+// ----- Command (bridge -> gateway) --------------------------------------
+// What server.py sends for a slider move, in both framings.
+constexpr char kCommandJson[] =
+    "{\"command\":\"forward\",\"tankId\":\"tank_001\",\"leftSpeed\":200,\"rightSpeed\":180,"
+    "\"seq\":17}";
+uint8_t commandBin[sizeof(BridgeProtocol::CommandMessage)];
+
+// handleCommand's parse, minus the queueing.
+void decodeCommandJson(long) {
+  arena.reset();
+  JsonDocument doc(&arena);
+  BridgeJson::Inbound msg;
+  if (BridgeJson::parseInbound(doc, kCommandJson, kDefaultSpeed, msg) || msg.type ||
+      !msg.command || (msg.tankId && strcmp(msg.tankId, kTankId) != 0)) {
+    return;
+  }
+  TankControl::Command cmd;
+  if (!TankControl::commandFromToken(msg.command, strlen(msg.command), cmd)) {
+    return;
+  }
+  sink = sink + static_cast<uint8_t>(cmd) + msg.leftSpeed + msg.rightSpeed + msg.sequence;
+}
+
+// handleBinaryMessage's decode, minus the queueing.
+void decodeCommandBin(long) {
+  BridgeProtocol::CommandMessage msg;
+  if (!BridgeProtocol::decode(commandBin, sizeof(commandBin), msg) ||
+      msg.command > static_cast<uint8_t>(TankControl::Command::SetSpeed) || msg.tank != 0) {
+    return;
+  }
+  sink = sink + msg.command + msg.leftSpeed + msg.rightSpeed + msg.sequence;
+}
+
+// ----- Ack (gateway -> bridge) ------------------------------------------
+size_t ackJsonLength = 0;
+
+void encodeAckJson(long i) {
+  const BridgeJson::Ack ack{kTankId, "forward", static_cast<uint16_t>(i),
+                            static_cast<uint8_t>(i), 200, 180,
+                            static_cast<uint32_t>(1500 + (i & 0x3FF))};
+  ackJsonLength = BridgeJson::writeAck(ack, outbound, sizeof(outbound));
+  sink = sink + ackJsonLength;
+}
+
+void encodeAckBin(long i) {
+  BridgeProtocol::AckMessage ack{};
+  ack.command = static_cast<uint8_t>(TankControl::Command::Forward);
+  ack.leftSpeed = 200;
+  ack.rightSpeed = 180;
+  ack.sequence = static_cast<uint16_t>(i);
+  ack.radioSequence = static_cast<uint8_t>(i);
+  ack.flags = BridgeProtocol::kAckTransmitted;
+  ack.gatewayUs = 1500 + (i & 0x3FF);
+  sink = sink + BridgeProtocol::encode(ack, reinterpret_cast<uint8_t *>(outbound),
+                                       sizeof(outbound));
+}
+
+// ----- Status (gateway -> bridge) ---------------------------------------
+// On a JSON link the gateway fields go out as a delta (publishDelta); on a
+// bin1 link as a StatusMessage per tank (publishBinaryStatus).
+size_t deltaJsonLength = 0;
+
+void encodeDeltaJson(long i) {
+  arena.reset();
+  JsonDocument doc(&arena);
+  const BridgeJson::Delta delta{kTankId, true, static_cast<int8_t>(-60 - (i & 7)),
+                                true, static_cast<uint32_t>(181234 - (i & 0xFFF)),
+                                true, static_cast<uint32_t>(i / 7)};
+  deltaJsonLength = BridgeJson::writeDelta(doc, delta, outbound, sizeof(outbound));
+  sink = sink + deltaJsonLength;
+}
+
+void encodeStatusBin(long i) {
+  BridgeProtocol::StatusMessage status{};
+  status.state = static_cast<uint8_t>(TankControl::Command::Forward);
+  status.leftSpeed = 200;
+  status.rightSpeed = 180;
+  status.wifiRssi = static_cast<int8_t>(-60 - (i & 7));
+  status.channel = 3;
+  status.uptimeS = static_cast<uint32_t>(i);
+  status.freeHeap = static_cast<uint32_t>(181234 - (i & 0xFFF));
+  status.superseded = static_cast<uint32_t>(i / 7);
+  sink = sink + BridgeProtocol::encode(status, reinterpret_cast<uint8_t *>(outbound),
+                                       sizeof(outbound));
+}
+
+}  // namespace
+
+int main() {
+  BridgeProtocol::CommandMessage command{};
+  command.command = static_cast<uint8_t>(TankControl::Command::Forward);
+  command.flags = BridgeProtocol::kHasLeftSpeed | BridgeProtocol::kHasRightSpeed;
+  command.leftSpeed = 200;
+  command.rightSpeed = 180;
+  command.sequence = 17;
+  BridgeProtocol::encode(command, commandBin, sizeof(commandBin));
+
+  std::printf("%ld iterations per row\n", kIterations);
+  double json = nsPerOp(decodeCommandJson);
+  double bin = nsPerOp(decodeCommandBin);
+  report("command decode", json, sizeof(kCommandJson) - 1, bin, sizeof(commandBin));
+  json = nsPerOp(encodeAckJson);
+  bin = nsPerOp(encodeAckBin);
+  report("ack encode", json, ackJsonLength, bin, sizeof(BridgeProtocol::AckMessage));
+  json = nsPerOp(encodeDeltaJson);
+  bin = nsPerOp(encodeStatusBin);
+  report("status encode", json, deltaJsonLength, bin, sizeof(BridgeProtocol::StatusMessage));
+
+  if (arena.overflows()) {
+    std::printf("arena overflowed %lu times\n", static_cast<unsigned long>(arena.overflows()));
+    return 1;
+  }
+  return 0;
+}
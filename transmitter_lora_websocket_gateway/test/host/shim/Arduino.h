@@ -0,0 +1,18 @@
+#pragma once
+// Just enough of the Arduino core for the gateway's portable headers
+// (BridgeProtocol.h, ControlProtocol.h, JsonArena.h) to build on the host.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  size_t printf(const char *, ...) { return 0; }
+};
@@ -0,0 +1,211 @@
+// Host test: once warmed up, the gateway's command and telemetry path never
+// touches the heap. Global operator new and malloc/calloc/realloc (wrapped
+// at link time, see Makefile) are counted across kRounds commands, acks,
+// deltas and sensor messages, each through the code main.cpp calls:
+// BridgeJson on the per-task JsonArena and BridgeProtocol for bin1.
+// A JsonDocument on the default allocator is the control that shows the
+// counter sees ArduinoJson's allocations at all. Run with `make test`.
+#include <ArduinoJson.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "BridgeJson.h"
+#include "BridgeProtocol.h"
+#include "ControlProtocol.h"
+#include "JsonArena.h"
+
+namespace {
+
+unsigned long heapCalls = 0;
+bool counting = false;
+
+void countHeapCall() {
+  if (counting) {
+    ++heapCalls;
+  }
+}
+
+}  // namespace
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  countHeapCall();
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  countHeapCall();
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  countHeapCall();
+  return __real_realloc(ptr, size);
+}
+}
+
+void *operator new(size_t size) {
+  countHeapCall();
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+constexpr int kRounds = 1000;
+constexpr size_t kWsOutboundMax = 1024;  // main.cpp WsOutbound::data
+constexpr char kTankId[] = "tank_001";
+
+JsonArena<4096> commandArena;  // as main.cpp
+JsonArena<2048> radioArena;
+char outbound[kWsOutboundMax];
+volatile uint32_t sink;
+int failures = 0;
+
+#define CHECK(cond)                                                       \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++failures;                                                         \
+    }                                                                     \
+  } while (0)
+
+const char *const kCommands[] = {
+    "{\"command\":\"forward\",\"tankId\":\"tank_001\",\"leftSpeed\":200,\"rightSpeed\":180,"
+    "\"seq\":17}",
+    "{\"command\":\"Stop\",\"tankId\":\"tank_001\",\"seq\":18}",
+    "{\"command\":\"setspeed\",\"leftSpeed\":90,\"rightSpeed\":120,\"seq\":19}",
+    "{\"command\":\"LEFT\",\"tankId\":\"tank_001\",\"seq\":20}",
+};
+
+// handleCommand up to queueCommand.
+void parseCommand(int round) {
+  commandArena.reset();
+  JsonDocument doc(&commandArena);
+  BridgeJson::Inbound msg;
+  CHECK(!BridgeJson::parseInbound(doc, kCommands[round % 4], 150, msg));
+  CHECK(msg.type == nullptr);
+  CHECK(msg.command != nullptr);
+  if (!msg.command) {
+    return;
+  }
+  CHECK(!msg.tankId || strcmp(msg.tankId, kTankId) == 0);
+  TankControl::Command cmd;
+  CHECK(TankControl::commandFromToken(msg.command, strlen(msg.command), cmd));
+  CHECK(msg.sequence == 17 + round % 4);
+  sink = sink + static_cast<uint8_t>(cmd) + msg.leftSpeed + msg.rightSpeed;
+}
+
+// handleBinaryMessage up to queueCommand.
+void parseBinaryCommand(int round) {
+  BridgeProtocol::CommandMessage msg{};
+  msg.command = static_cast<uint8_t>(round % 6);
+  msg.sequence = static_cast<uint16_t>(round);
+  uint8_t wire[sizeof(msg)];
+  CHECK(BridgeProtocol::encode(msg, wire, sizeof(wire)) == sizeof(wire));
+  BridgeProtocol::CommandMessage decoded;
+  CHECK(BridgeProtocol::decode(wire, sizeof(wire), decoded));
+  sink = sink + decoded.command + decoded.sequence;
+}
+
+// publishJsonAck and the bin1 ack.
+void publishAcks(int round) {
+  const BridgeJson::Ack ack{kTankId, "forward", static_cast<uint16_t>(round),
+                            static_cast<uint8_t>(round), 200, 180,
+                            static_cast<uint32_t>(1500 + round)};
+  CHECK(BridgeJson::writeAck(ack, outbound, sizeof(outbound)) > 0);
+  BridgeProtocol::AckMessage binary{};
+  binary.sequence = static_cast<uint16_t>(round);
+  CHECK(BridgeProtocol::encode(binary, reinterpret_cast<uint8_t *>(outbound),
+                               sizeof(outbound)) == sizeof(binary));
+}
+
+// publishDelta, forwardSensorPacket and publishBinaryStatus.
+void publishDeltaSensorAndBinary(int round) {
+  commandArena.reset();
+  {
+    JsonDocument doc(&commandArena);
+    const BridgeJson::Delta delta{kTankId, true, static_cast<int8_t>(-60 - round % 10),
+                                  true, static_cast<uint32_t>(181234 - round),
+                                  round % 2 == 0, static_cast<uint32_t>(34567 + round)};
+    CHECK(BridgeJson::writeDelta(doc, delta, outbound, sizeof(outbound)) > 0);
+  }
+
+  radioArena.reset();
+  {
+    JsonDocument doc(&radioArena);
+    const BridgeJson::Sensor sensor{
+        kTankId, -97, 6.25f, -1234, static_cast<uint32_t>(86400000 + round),
+        "{\"latitude\":{\"value\":6.267417,\"type\":\"Float\"},"
+        "\"temperature\":{\"value\":24.31,\"type\":\"Float\"}}"};
+    CHECK(BridgeJson::writeSensor(doc, sensor, outbound, sizeof(outbound)) > 0);
+  }
+
+  BridgeProtocol::StatusMessage status{};
+  status.uptimeS = static_cast<uint32_t>(round);
+  CHECK(BridgeProtocol::encode(status, reinterpret_cast<uint8_t *>(outbound),
+                               sizeof(outbound)) == sizeof(status));
+}
+
+void hotPath(int round) {
+  parseCommand(round);
+  parseBinaryCommand(round);
+  publishAcks(round);
+  publishDeltaSensorAndBinary(round);
+}
+
+}  // namespace
+
+int main() {
+  // Control: ArduinoJson's default allocator is the heap, and it is seen.
+  counting = true;
+  {
+    JsonDocument doc;
+    CHECK(!deserializeJson(doc, kCommands[0]));
+  }
+  counting = false;
+  CHECK(heapCalls > 0);
+  const unsigned long controlCalls = heapCalls;
+
+  // Warm-up, then the counted rounds.
+  for (int round = 0; round < 4; ++round) {
+    hotPath(round);
+  }
+  heapCalls = 0;
+  counting = true;
+  for (int round = 0; round < kRounds; ++round) {
+    hotPath(round);
+  }
+  counting = false;
+
+  if (heapCalls != 0) {
+    std::printf("hot path made %lu heap calls in %d rounds\n", heapCalls, kRounds);
+    ++failures;
+  }
+  CHECK(commandArena.overflows() == 0);
+  CHECK(radioArena.overflows() == 0);
+
+  if (failures) {
+    std::printf("test_heap_hot_path: %d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("test_heap_hot_path: OK (%d rounds, 0 heap calls; control %lu; arena peak "
+              "cmd %u/%u radio %u/%u)\n",
+              kRounds, controlCalls, static_cast<unsigned>(commandArena.peak()),
+              static_cast<unsigned>(commandArena.capacity()),
+              static_cast<unsigned>(radioArena.peak()),
+              static_cast<unsigned>(radioArena.capacity()));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+// Host test for TankMotion: heartbeats end with a queued Stop, and a failed
+// Stop is owed until one goes on air. Run with `make test` (see Makefile).
+#include <cstdio>
+#include <cstdlib>
+#include "TankMotion.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                       \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++failures;                                                         \
+    }                                                                     \
+  } while (0)
+
+using TankControl::Command;
+
+// A motion command that went on air.
+TankMotion moving() {
+  TankMotion motion;
+  const uint32_t generation = motion.queued(Command::Forward);
+  motion.result(generation, Command::Forward, 200, 180, true);
+  return motion;
+}
+
+void testHeartbeatRepeatsMotion() {
+  TankMotion motion = moving();
+  CHECK(motion.heartbeatDue());
+  CHECK(motion.motion() == Command::Forward);
+  CHECK(motion.left() == 200 && motion.right() == 180);
+
+  // SetSpeed keeps the direction.
+  const uint32_t generation = motion.queued(Command::SetSpeed);
+  motion.result(generation, Command::SetSpeed, 90, 80, true);
+  CHECK(motion.motion() == Command::Forward);
+  CHECK(motion.left() == 90 && motion.right() == 80);
+  CHECK(motion.heartbeatDue());
+}
+
+void testFailedStopEndsHeartbeats() {
+  TankMotion motion = moving();
+  const uint32_t generation = motion.queued(Command::Stop);
+  CHECK(!motion.heartbeatDue());  // from the moment it is queued
+  CHECK(!motion.stopRetryDue());  // not failed yet
+
+  motion.result(generation, Command::Stop, 0, 0, false);
+  CHECK(!motion.heartbeatDue());
+  CHECK(motion.stopRetryDue());
+
+  // The retry fails too: still no heartbeats, still owed.
+  const uint32_t retry = motion.queued(Command::Stop);
+  CHECK(!motion.stopRetryDue());
+  motion.result(retry, Command::Stop, 0, 0, false);
+  CHECK(!motion.heartbeatDue());
+  CHECK(motion.stopRetryDue());
+
+  // And goes on air.
+  const uint32_t last = motion.queued(Command::Stop);
+  motion.result(last, Command::Stop, 0, 0, true);
+  CHECK(!motion.heartbeatDue());
+  CHECK(!motion.stopRetryDue());
+}
+
+void testStaleResultsIgnored() {
+  TankMotion motion = moving();
+  // A heartbeat taken for the radio before the Stop was queued comes back
+  // after it: it must not bring the motion back.
+  const uint32_t heartbeat = motion.generation();
+  motion.queued(Command::Stop);
+  motion.result(heartbeat, Command::Forward, 200, 180, true);
+  CHECK(!motion.heartbeatDue());
+
+  // A Stop that failed after a newer command was queued is not retried.
+  TankMotion replaced = moving();
+  const uint32_t stop = replaced.queued(Command::Stop);
+  const uint32_t backward = replaced.queued(Command::Backward);
+  replaced.result(stop, Command::Stop, 0, 0, false);
+  CHECK(!replaced.stopRetryDue());
+  replaced.result(backward, Command::Backward, 100, 100, true);
+  CHECK(replaced.heartbeatDue());
+  CHECK(replaced.motion() == Command::Backward);
+}
+
+void testFailedMotionKeepsOldState() {
+  TankMotion motion;
+  const uint32_t generation = motion.queued(Command::Forward);
+  motion.result(generation, Command::Forward, 200, 180, false);
+  CHECK(!motion.heartbeatDue());  // never on air: nothing to refresh
+  CHECK(!motion.stopRetryDue());
+}
+
+}  // namespace
+
+int main() {
+  testHeartbeatRepeatsMotion();
+  testFailedStopEndsHeartbeats();
+  testStaleResultsIgnored();
+  testFailedMotionKeepsOldState();
+  if (failures) {
+    std::printf("test_tank_motion: %d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("test_tank_motion: OK\n");
+  return EXIT_SUCCESS;
+}